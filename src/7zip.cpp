@@ -57,6 +57,7 @@ public:
 	QString entryName(int index) const;
 	bool entryIsDirectory(int index) const;
 	std::optional<std::uint32_t> entryCrc32(int index) const;
+	std::uint64_t entrySize(int index) const;
 
 private:
 	static const ISzAlloc			s_allocImpl;
@@ -152,35 +153,92 @@ bool SevenZipFile::open(const QString &path)
 std::unique_ptr<QIODevice> SevenZipFile::get(const QString &fileName)
 {
 	ProfilerScope prof(CURRENT_FUNCTION);
+	std::optional<int> index = find(fileName);
+	return index
+		? m_impl->extract(*index)
+		: std::unique_ptr<QIODevice>();
+}
+
+
+//-------------------------------------------------
+//  get(std::uint32_t crc32)
+//-------------------------------------------------
+
+std::unique_ptr<QIODevice> SevenZipFile::get(std::uint32_t crc32)
+{
+	ProfilerScope prof(CURRENT_FUNCTION);
+	std::optional<int> index = find(crc32);
+	return index
+		? m_impl->extract(*index)
+		: std::unique_ptr<QIODevice>();
+}
+
+
+//-------------------------------------------------
+//  getInfo(const QString &fileName)
+//-------------------------------------------------
+
+std::optional<SevenZipFile::EntryInfo> SevenZipFile::getInfo(const QString &fileName)
+{
+	return getInfo(find(fileName));
+}
+
+
+//-------------------------------------------------
+//  getInfo(std::uint32_t crc32)
+//-------------------------------------------------
+
+std::optional<SevenZipFile::EntryInfo> SevenZipFile::getInfo(std::uint32_t crc32)
+{
+	return getInfo(find(crc32));
+}
+
+
+//-------------------------------------------------
+//  getInfo(std::optional<int> index)
+//-------------------------------------------------
 
+std::optional<SevenZipFile::EntryInfo> SevenZipFile::getInfo(std::optional<int> index) const
+{
+	std::optional<EntryInfo> result;
+	if (index)
+		result = EntryInfo { m_impl->entryName(*index), m_impl->entrySize(*index), m_impl->entryCrc32(*index) };
+	return result;
+}
+
+
+//-------------------------------------------------
+//  find(const QString &fileName)
+//-------------------------------------------------
+
+std::optional<int> SevenZipFile::find(const QString &fileName)
+{
 	// find this file
 	QString normalizedFileName = normalizeFileName(fileName);
 	auto iter = m_filesByName.find(normalizedFileName);
 
-	// extract or populate as appropriate
+	// populate as appropriate
 	std::optional<int> index = iter != m_filesByName.end()
 		? iter->second
 		: std::optional<int>();
-	return extractOrPopulate(index, normalizedFileName, { });
+	return findOrPopulate(index, normalizedFileName, { });
 }
 
 
 //-------------------------------------------------
-//  get(std::uint32_t crc32)
+//  find(std::uint32_t crc32)
 //-------------------------------------------------
 
-std::unique_ptr<QIODevice> SevenZipFile::get(std::uint32_t crc32)
+std::optional<int> SevenZipFile::find(std::uint32_t crc32)
 {
-	ProfilerScope prof(CURRENT_FUNCTION);
-
 	// find this file
 	auto iter = m_filesByCrc32.find(crc32);
 
-	// extract or populate as appropriate
+	// populate as appropriate
 	std::optional<int> index = iter != m_filesByCrc32.end()
 		? iter->second
 		: std::optional<int>();
-	return extractOrPopulate(index, { }, crc32);
+	return findOrPopulate(index, { }, crc32);
 }
 
 
@@ -195,10 +253,10 @@ QString SevenZipFile::normalizeFileName(const QString &fileName)
 
 
 //-------------------------------------------------
-//  extractOrPopulate
+//  findOrPopulate
 //-------------------------------------------------
 
-std::unique_ptr<QIODevice> SevenZipFile::extractOrPopulate(
+std::optional<int> SevenZipFile::findOrPopulate(
 	std::optional<int> index,
 	const std::optional<QString> &targetNormalizedFileName,
 	std::optional<std::uint32_t> targetCrc32)
@@ -233,10 +291,8 @@ std::unique_ptr<QIODevice> SevenZipFile::extractOrPopulate(
 		m_cursor++;
 	}
 
-	// we're done; do we have an index to extract?
-	return index
-		? m_impl->extract(*index)
-		: std::unique_ptr<QIODevice>();
+	// we're done
+	return index;
 }
 
 
@@ -392,6 +448,16 @@ std::optional<std::uint32_t> SevenZipFile::Impl::entryCrc32(int index) const
 }
 
 
+//-------------------------------------------------
+//  Impl::entrySize
+//-------------------------------------------------
+
+std::uint64_t SevenZipFile::Impl::entrySize(int index) const
+{
+	return SzArEx_GetFileSize(&m_db, index);
+}
+
+
 //-------------------------------------------------
 //  Impl::doRead
 //-------------------------------------------------
@@ -26,9 +26,19 @@ public:
 	SevenZipFile(SevenZipFile &&) = delete;
 	~SevenZipFile();
 
+	// describes an entry without extracting it
+	struct EntryInfo
+	{
+		QString							m_name;
+		std::uint64_t					m_size;
+		std::optional<std::uint32_t>	m_crc32;
+	};
+
 	bool open(const QString &path);
 	std::unique_ptr<QIODevice> get(const QString &fileName);
 	std::unique_ptr<QIODevice> get(std::uint32_t crc32);
+	std::optional<EntryInfo> getInfo(const QString &fileName);
+	std::optional<EntryInfo> getInfo(std::uint32_t crc32);
 
 private:
 	class Impl;
@@ -39,10 +49,13 @@ private:
 	int										m_cursor;
 
 	static QString normalizeFileName(const QString &fileName);
-	std::unique_ptr<QIODevice> extractOrPopulate(
+	std::optional<int> find(const QString &fileName);
+	std::optional<int> find(std::uint32_t crc32);
+	std::optional<int> findOrPopulate(
 		std::optional<int> index,
 		const std::optional<QString> &normalizedFileName,
 		std::optional<std::uint32_t> crc32);
+	std::optional<EntryInfo> getInfo(std::optional<int> index) const;
 };
 
 
@@ -32,6 +32,7 @@ public:
 
 	virtual ~Lookup() { }
 	virtual std::unique_ptr<QIODevice> getAsset(const QString &fileName, std::optional<std::uint32_t> crc32) = 0;
+	virtual std::optional<AssetInfo> getAssetInfo(const QString &fileName, std::optional<std::uint32_t> crc32) = 0;
 };
 
 
@@ -49,6 +50,15 @@ public:
 		return std::make_unique<QFile>(m_path + "/" + fileName);
 	}
 
+	virtual std::optional<AssetInfo> getAssetInfo(const QString &fileName, std::optional<std::uint32_t> crc32) override
+	{
+		// getAsset() skips files that cannot be opened, so we have to as well
+		QFileInfo fi(m_path + "/" + fileName);
+		return fi.isFile() && QFile(fi.filePath()).open(QIODevice::ReadOnly)
+			? AssetInfo { fi.absoluteFilePath(), QString(), (std::uint64_t)fi.size(), fi.lastModified(), std::nullopt }
+			: std::optional<AssetInfo>();
+	}
+
 private:
 	QString		m_path;
 };
@@ -60,6 +70,7 @@ class AssetFinder::ZipFileLookup : public AssetFinder::Lookup
 public:
 	ZipFileLookup(const QString &path)
 		: m_zip(path)
+		, m_lastModified(QFileInfo(path).lastModified())
 	{
 	}
 
@@ -78,6 +89,16 @@ public:
 		return std::make_unique<QuaZipFile>(&m_zip);
 	}
 
+	virtual std::optional<AssetInfo> getAssetInfo(const QString &fileName, std::optional<std::uint32_t> crc32) override
+	{
+		// find the file, and read the central directory's record of it
+		QuaZipFileInfo64 fi;
+		if (!findFileInZip(fileName, crc32) || !m_zip.getCurrentFileInfo(&fi))
+			return { };
+
+		return AssetInfo { m_zip.getZipName(), std::move(fi.name), fi.uncompressedSize, m_lastModified, fi.crc };
+	}
+
 	static Lookup::ptr tryOpen(const QString &path)
 	{
 		auto lookup = std::make_unique<ZipFileLookup>(path);
@@ -88,6 +109,7 @@ public:
 
 private:
 	QuaZip														m_zip;
+	QDateTime													m_lastModified;
 	std::optional<std::unordered_map<std::uint32_t, QString>>	m_crc32Map;
 
 	bool findFileInZip(const QString &fileName, std::optional<std::uint32_t> crc32)
@@ -132,6 +154,8 @@ class AssetFinder::SevenZipFileLookup : public AssetFinder::Lookup
 public:
 	bool open(const QString &path)
 	{
+		m_path = path;
+		m_lastModified = QFileInfo(path).lastModified();
 		return m_7zipFile.open(path);
 	}
 
@@ -148,6 +172,20 @@ public:
 		return file;
 	}
 
+	virtual std::optional<AssetInfo> getAssetInfo(const QString &fileName, std::optional<std::uint32_t> crc32) override
+	{
+		// like getAsset(), try the CRC-32 first
+		std::optional<SevenZipFile::EntryInfo> entryInfo;
+		if (crc32)
+			entryInfo = m_7zipFile.getInfo(*crc32);
+		if (!entryInfo)
+			entryInfo = m_7zipFile.getInfo(fileName);
+		if (!entryInfo)
+			return { };
+
+		return AssetInfo { m_path, std::move(entryInfo->m_name), entryInfo->m_size, m_lastModified, entryInfo->m_crc32 };
+	}
+
 	static Lookup::ptr tryOpen(const QString &path)
 	{
 		auto lookup = std::make_unique<SevenZipFileLookup>();
@@ -158,6 +196,8 @@ public:
 
 private:
 	SevenZipFile	m_7zipFile;
+	QString			m_path;
+	QDateTime		m_lastModified;
 };
 
 
@@ -255,17 +295,28 @@ void AssetFinder::setPaths(const Preferences &prefs, Preferences::global_path_ty
 
 
 //-------------------------------------------------
-//  findAsset
+//  findAsset - finds and opens an asset; if
+//	assetInfo is specified, it receives the
+//	description of the asset actually opened
 //-------------------------------------------------
 
-std::unique_ptr<QIODevice> AssetFinder::findAsset(const QString &fileName, std::optional<std::uint32_t> crc32) const
+std::unique_ptr<QIODevice> AssetFinder::findAsset(const QString &fileName, std::optional<std::uint32_t> crc32, std::optional<AssetInfo> *assetInfo) const
 {
 	ProfilerScope prof(CURRENT_FUNCTION);
 	for (const Lookup::ptr &lookup : m_lookups)
 	{
+		// describe the asset before opening it; a ZIP file can only have one current file
+		std::optional<AssetInfo> info = assetInfo
+			? lookup->getAssetInfo(fileName, crc32)
+			: std::nullopt;
+
 		std::unique_ptr<QIODevice> stream = lookup->getAsset(fileName, crc32);
 		if (stream && stream->open(QIODevice::ReadOnly))
+		{
+			if (assetInfo)
+				*assetInfo = std::move(info);
 			return stream;
+		}
 	}
 	return { };
 }
@@ -285,6 +336,25 @@ std::optional<QByteArray> AssetFinder::findAssetBytes(const QString &fileName, s
 }
 
 
+//-------------------------------------------------
+//  findAssetInfo - finds the asset that findAsset()
+//	would return, but describes it rather than
+//	opening it (no decompression takes place)
+//-------------------------------------------------
+
+std::optional<AssetFinder::AssetInfo> AssetFinder::findAssetInfo(const QString &fileName, std::optional<std::uint32_t> crc32) const
+{
+	ProfilerScope prof(CURRENT_FUNCTION);
+	for (const Lookup::ptr &lookup : m_lookups)
+	{
+		std::optional<AssetInfo> result = lookup->getAssetInfo(fileName, crc32);
+		if (result)
+			return result;
+	}
+	return { };
+}
+
+
 //-------------------------------------------------
 //  isValidArchive - utility method housed here
 //	to insulate rest of app from QuaZip
@@ -13,6 +13,7 @@
 #include "prefs.h"
 
 // Qt headers
+#include <QDateTime>
 #include <QStringList>
 #include <QIODevice>
 
@@ -25,6 +26,16 @@
 class AssetFinder
 {
 public:
+	// describes an asset without opening it
+	struct AssetInfo
+	{
+		QString							m_path;				// the file, or the archive containing it
+		QString							m_member;			// the name within the archive (empty for plain files)
+		std::uint64_t					m_size;				// uncompressed size
+		QDateTime						m_lastModified;		// of the file or archive
+		std::optional<std::uint32_t>	m_crc32;			// as recorded by the archive, if any
+	};
+
 	// ctor/dtor
 	AssetFinder();
 	AssetFinder(QStringList &&paths);
@@ -36,8 +47,9 @@ public:
 	// methods
 	void setPaths(QStringList &&paths);
 	void setPaths(const Preferences &prefs, Preferences::global_path_type pathType);
-	std::unique_ptr<QIODevice> findAsset(const QString &fileName, std::optional<std::uint32_t> crc32 = { }) const;
+	std::unique_ptr<QIODevice> findAsset(const QString &fileName, std::optional<std::uint32_t> crc32 = { }, std::optional<AssetInfo> *assetInfo = nullptr) const;
 	std::optional<QByteArray> findAssetBytes(const QString &fileName, std::optional<std::uint32_t> crc32 = { }) const;
+	std::optional<AssetInfo> findAssetInfo(const QString &fileName, std::optional<std::uint32_t> crc32 = { }) const;
 
 	// statics
 	static bool isValidArchive(const QString &path);
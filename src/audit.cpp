@@ -10,6 +10,7 @@
 #include "audit.h"
 #include "assetfinder.h"
 #include "chd.h"
+#include "hashcache.h"
 
 
 //**************************************************************************
@@ -54,10 +55,10 @@ Audit::Audit()
 //  calculateHashForFile
 //-------------------------------------------------
 
-static Audit::Entry::CalculateHashStatus calculateHashForFile(QIODevice &stream, const Hash::CalculateCallback &callback, Hash &result)
+static Audit::Entry::CalculateHashStatus calculateHashForFile(QIODevice &stream, bool useCrc32, bool useSha1, const Hash::CalculateCallback &callback, Hash &result)
 {
-	// calculate the hash
-	std::optional<Hash> hash = Hash::calculate(stream, callback);
+	// calculate the hash (or hashes) that we need; if none, we don't read the file at all
+	std::optional<Hash> hash = Hash::calculate(stream, callback, useCrc32, useSha1);
 
 	// return the result
 	result = hash.value_or(Hash());
@@ -73,9 +74,10 @@ static Audit::Entry::CalculateHashStatus calculateHashForFile(QIODevice &stream,
 //  calculateHashForChd
 //-------------------------------------------------
 
-static Audit::Entry::CalculateHashStatus calculateHashForChd(QIODevice &stream, const Hash::CalculateCallback &callback, Hash &result)
+static Audit::Entry::CalculateHashStatus calculateHashForChd(QIODevice &stream, bool useCrc32, bool useSha1, const Hash::CalculateCallback &callback, Hash &result)
 {
-	// calculate the hash
+	// calculate the hash; this only reads the CHD header, so we always do it in order to catch
+	// corrupt CHDs
 	std::optional<Hash> hash = getHashForChd(stream);
 
 	// return the result
@@ -193,10 +195,12 @@ int Audit::appendPaths(QStringList &&paths)
 
 
 //-------------------------------------------------
-//  run
+//  run - runs the audit; quick audits trust the
+//	sizes and CRC-32s that archives record for
+//	their members instead of decompressing them
 //-------------------------------------------------
 
-std::optional<AuditStatus> Audit::run(ICallback &callback) const
+std::optional<AuditStatus> Audit::run(ICallback &callback, HashCache *hashCache, bool quick) const
 {
 	Session session(callback);
 	std::vector<std::unique_ptr<AssetFinder>> assetFinders;
@@ -204,7 +208,7 @@ std::optional<AuditStatus> Audit::run(ICallback &callback) const
 	// loop through all entries
 	int i = 0;
 	for (i = 0; !session.hasAborted() && i < m_entries.size(); i++)
-		auditSingleMedia(session, i, assetFinders);
+		auditSingleMedia(session, i, assetFinders, hashCache, quick);
 
 	// report the results accordingly - note that hypothetically we could have been
 	// aborted after we completed, in which case we want to report complete results
@@ -218,7 +222,7 @@ std::optional<AuditStatus> Audit::run(ICallback &callback) const
 //  auditSingleMedia
 //-------------------------------------------------
 
-void Audit::auditSingleMedia(Session &session, int entryIndex, std::vector<std::unique_ptr<AssetFinder>> &assetFinders) const
+void Audit::auditSingleMedia(Session &session, int entryIndex, std::vector<std::unique_ptr<AssetFinder>> &assetFinders, HashCache *hashCache, bool quick) const
 {
 	// find the entry
 	const Entry &entry = m_entries[entryIndex];
@@ -238,18 +242,59 @@ void Audit::auditSingleMedia(Session &session, int entryIndex, std::vector<std::
 	// identify the AssetFinder
 	const AssetFinder &assetFinder = *assetFinders[entry.pathsPosition()];
 
-	// try to find the asset
-	std::unique_ptr<QIODevice> stream = assetFinder.findAsset(
-		entry.name(),
-		entry.expectedHash().crc32());
-
 	// get critical information
 	std::optional<std::uint64_t> actualSize;
 	Hash actualHash;
+	std::optional<Verdict::Type> verdictType;
+
+	// if we have a hash cache or are doing a quick audit, we want to know about the asset before opening it; and
+	// if we don't need any hashes (samples, nodumps) this is all we need to know, so we never open it at all
+	bool requiresHash = entry.requiresCrc32() || entry.requiresSha1();
+	std::optional<AssetFinder::AssetInfo> assetInfo;
+	if (hashCache || quick || !requiresHash)
+		assetInfo = assetFinder.findAssetInfo(entry.name(), entry.expectedHash().crc32());
+
+	// we might already know the hashes of this asset
+	std::optional<Hash> cachedHash = assetInfo && hashCache && requiresHash
+		? hashCache->find(*assetInfo, entry.requiresCrc32(), entry.requiresSha1())
+		: std::nullopt;
+
+	// failing that, quick audits can go by what the archive says about the asset
+	bool useArchiveMetadata = !cachedHash && quick && assetInfo && assetInfo->m_crc32 && entry.requiresCrc32();
+
+	// try to find the asset (unless we don't need to); any hash we calculate is cached under the asset that
+	// was actually opened, which is not necessarily the one we looked up above
+	std::optional<AssetFinder::AssetInfo> streamAssetInfo;
+	std::unique_ptr<QIODevice> stream = requiresHash && !cachedHash && !useArchiveMetadata
+		? assetFinder.findAsset(entry.name(), entry.expectedHash().crc32(), hashCache ? &streamAssetInfo : nullptr)
+		: std::unique_ptr<QIODevice>();
 
 	// and time to get a verdict
-	std::optional<Verdict::Type> verdictType;
-	if (!stream)
+	if (!requiresHash)
+	{
+		// all that matters is that the asset is there, and its size
+		actualSize = assetInfo ? assetInfo->m_size : 0;
+		verdictType = assetInfo
+			? evaluateHashes(entry.expectedSize(), entry.expectedHash(), *actualSize, actualHash, entry.dumpStatus())
+			: Verdict::Type::NotFound;
+	}
+	else if (cachedHash)
+	{
+		// the hash cache had what we need
+		actualSize = assetInfo->m_size;
+		actualHash = *cachedHash;
+		verdictType = evaluateHashes(entry.expectedSize(), entry.expectedHash(), *actualSize, actualHash, entry.dumpStatus());
+	}
+	else if (useArchiveMetadata)
+	{
+		// the archive vouches for the size and CRC-32, but nothing more
+		actualSize = assetInfo->m_size;
+		actualHash = Hash(assetInfo->m_crc32);
+		verdictType = evaluateHashes(entry.expectedSize(), entry.expectedHash().mask(true, false), *actualSize, actualHash, entry.dumpStatus());
+		if (verdictType == Verdict::Type::Ok)
+			verdictType = Verdict::Type::OkMetadataVerified;
+	}
+	else if (!stream)
 	{
 		// this entry was not found at all
 		verdictType = Verdict::Type::NotFound;
@@ -265,12 +310,16 @@ void Audit::auditSingleMedia(Session &session, int entryIndex, std::vector<std::
 		};
 
 		// calculate the hash
-		switch (entry.calculateHashFunc()(*stream, calculateHashCallback, actualHash))
+		switch (entry.calculateHashFunc()(*stream, entry.requiresCrc32(), entry.requiresSha1(), calculateHashCallback, actualHash))
 		{
 		case Entry::CalculateHashStatus::Success:
 			// we've successfully processed the hash - now evaluate them
 			actualSize = streamSize;
 			verdictType = evaluateHashes(entry.expectedSize(), entry.expectedHash(), *actualSize, actualHash, entry.dumpStatus());
+
+			// and remember them for next time
+			if (streamAssetInfo && hashCache)
+				hashCache->store(*streamAssetInfo, actualHash);
 			break;
 
 		case Entry::CalculateHashStatus::Cancelled:
@@ -290,7 +339,9 @@ void Audit::auditSingleMedia(Session &session, int entryIndex, std::vector<std::
 
 	// determine the audit status
 	AuditStatus status;
-	if (isVerdictSuccessful(*verdictType))
+	if (*verdictType == Verdict::Type::OkMetadataVerified)
+		status = AuditStatus::FoundMetadataOnly;
+	else if (isVerdictSuccessful(*verdictType))
 		status = AuditStatus::Found;
 	else if (entry.optional())
 		status = AuditStatus::MissingOptional;
@@ -347,6 +398,7 @@ bool Audit::isVerdictSuccessful(Audit::Verdict::Type verdictType)
 	{
 	case Audit::Verdict::Type::Ok:
 	case Audit::Verdict::Type::OkNoGoodDump:
+	case Audit::Verdict::Type::OkMetadataVerified:
 		result = true;
 		break;
 
@@ -386,6 +438,8 @@ Audit::Entry::Entry(Type type, const QString &name, int pathsPosition, Calculate
 	, m_expectedSize(expectedSize)
 	, m_expectedHash(expectedHash)
 	, m_optional(optional)
+	, m_requiresCrc32(dumpStatus != info::rom::dump_status_t::NODUMP && expectedHash.crc32())
+	, m_requiresSha1(dumpStatus != info::rom::dump_status_t::NODUMP && expectedHash.sha1())
 {
 }
 
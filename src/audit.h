@@ -21,6 +21,7 @@
 //**************************************************************************
 
 class AssetFinder;
+class HashCache;
 
 
 // ======================> Audit
@@ -40,6 +41,7 @@ public:
 			// successful verdicts
 			Ok,
 			OkNoGoodDump,
+			OkMetadataVerified,		// size and CRC-32 match according to the archive; not actually read
 
 			// error conditions
 			NotFound,
@@ -86,7 +88,7 @@ public:
 			CantProcess
 		};
 
-		typedef CalculateHashStatus(*CalculateHashFunc)(QIODevice &stream, const Hash::CalculateCallback &callback, Hash &result);
+		typedef CalculateHashStatus(*CalculateHashFunc)(QIODevice &stream, bool useCrc32, bool useSha1, const Hash::CalculateCallback &callback, Hash &result);
 
 		// ctor
 		Entry(Type type, const QString &name, int pathsPosition, CalculateHashFunc calculateHashFunc, info::rom::dump_status_t dumpStatus, std::optional<std::uint32_t> expectedSize, const Hash &expectedHash, bool optional);
@@ -102,6 +104,8 @@ public:
 		std::optional<std::uint32_t> expectedSize() const	{ return m_expectedSize; }
 		const Hash &expectedHash() const					{ return m_expectedHash; }
 		bool optional() const								{ return m_optional; }
+		bool requiresCrc32() const							{ return m_requiresCrc32; }
+		bool requiresSha1() const							{ return m_requiresSha1; }
 
 	private:
 		Type							m_type;
@@ -112,6 +116,8 @@ public:
 		std::optional<std::uint32_t>	m_expectedSize;
 		Hash							m_expectedHash;
 		bool							m_optional;
+		bool							m_requiresCrc32;
+		bool							m_requiresSha1;
 	};
 
 	// callback reported after each media is audited, should return true if aborted
@@ -131,7 +137,7 @@ public:
 	// methods
 	void addMediaForMachine(const Preferences &prefs, const info::machine &machine);
 	void addMediaForSoftware(const Preferences &prefs, const software_list::software &software);
-	std::optional<AuditStatus> run(ICallback &callback) const;
+	std::optional<AuditStatus> run(ICallback &callback, HashCache *hashCache = nullptr, bool quick = false) const;
 
 	// statics
 	static bool isVerdictSuccessful(Audit::Verdict::Type verdictType);
@@ -146,7 +152,7 @@ private:
 	// methods
 	QStringList buildMachinePaths(const Preferences &prefs, Preferences::global_path_type pathType, std::optional<info::machine> machine);
 	int appendPaths(QStringList &&paths);
-	void auditSingleMedia(Session &session, int entryIndex, std::vector<std::unique_ptr<AssetFinder>> &assetFinders) const;
+	void auditSingleMedia(Session &session, int entryIndex, std::vector<std::unique_ptr<AssetFinder>> &assetFinders, HashCache *hashCache, bool quick) const;
 	static Verdict::Type evaluateHashes(const std::optional<std::uint32_t> &expectedSize, const Hash &expectedHash,
 		std::uint64_t actualSize, const Hash &actualHash, info::rom::dump_status_t dumpStatus);
 };
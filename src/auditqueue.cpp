@@ -18,11 +18,12 @@
 //  ctor
 //-------------------------------------------------
 
-AuditQueue::AuditQueue(const Preferences &prefs, const info::database &infoDb, const software_list_collection &softwareListCollection, int maxAuditsPerTask)
+AuditQueue::AuditQueue(const Preferences &prefs, const info::database &infoDb, const software_list_collection &softwareListCollection, int maxAuditsPerTask, HashCache::ptr hashCache)
 	: m_prefs(prefs)
 	, m_infoDb(infoDb)
 	, m_softwareListCollection(softwareListCollection)
 	, m_maxAuditsPerTask(maxAuditsPerTask)
+	, m_hashCache(std::move(hashCache))
 	, m_currentCookie(100)
 {
 }
@@ -123,13 +124,10 @@ std::uint64_t AuditQueue::getExpectedMediaSize(const Identifier &auditIdentifier
 	{
 		[this, &result] (const MachineIdentifier &x)
 		{
-			// machine audit
+			// machine audit; the info DB has the total ROM size precomputed
 			std::optional<info::machine> machine = m_infoDb.find_machine(x.machineName());
 			if (machine)
-			{
-				for (info::rom rom : machine->roms())
-					result += rom.size();
-			}
+				result = machine->roms_size();
 		},
 		[this, &result](const SoftwareIdentifier &x)
 		{
@@ -161,8 +159,9 @@ std::uint64_t AuditQueue::getExpectedMediaSize(const Identifier &auditIdentifier
 
 AuditTask::ptr AuditQueue::createAuditTask(const std::vector<Identifier> &auditIdentifiers) const
 {
-	// create an audit task with a single audit
-	AuditTask::ptr auditTask = std::make_shared<AuditTask>(false, currentCookie());
+	// create an audit task with a single audit; these run in the background, and only trust archive metadata
+	// (quick audits) if the user opted into that
+	AuditTask::ptr auditTask = std::make_shared<AuditTask>(false, currentCookie(), m_hashCache, m_prefs.getQuickAuditing());
 
 	for (const Identifier &identifier : auditIdentifiers)
 	{
@@ -27,7 +27,7 @@ public:
 	class Test;
 
 	// ctor
-	AuditQueue(const Preferences &prefs, const info::database &infoDb, const software_list_collection &softwareListCollection, int maxAuditsPerTask);
+	AuditQueue(const Preferences &prefs, const info::database &infoDb, const software_list_collection &softwareListCollection, int maxAuditsPerTask, HashCache::ptr hashCache = { });
 
 	// accessors
 	bool hasUndispatched() const { return m_undispatchedAudits.size() > 0; }
@@ -46,6 +46,7 @@ private:
 	const info::database &				m_infoDb;
 	const software_list_collection &	m_softwareListCollection;
 	int									m_maxAuditsPerTask;
+	HashCache::ptr						m_hashCache;
 	AuditTaskMap						m_auditTaskMap;
 	std::deque<Identifier>				m_undispatchedAudits;
 	int									m_currentCookie;
@@ -45,8 +45,10 @@ private:
 //  ctor
 //-------------------------------------------------
 
-AuditTask::AuditTask(bool reportProgress, int cookie)
+AuditTask::AuditTask(bool reportProgress, int cookie, HashCache::ptr hashCache, bool quick)
 	: m_cookie(cookie)
+	, m_hashCache(std::move(hashCache))
+	, m_quick(quick)
 {
 	using namespace std::chrono_literals;
 
@@ -116,7 +118,7 @@ void AuditTask::run()
 	for (const Entry &entry : m_entries)
 	{
 		// run the audit
-		std::optional<AuditStatus> status = entry.m_audit.run(callback);
+		std::optional<AuditStatus> status = entry.m_audit.run(callback, m_hashCache.get(), m_quick);
 
 		// if we didn't get complete results, we've been aborted and bail
 		if (!status)
@@ -13,6 +13,7 @@
 #include <optional>
 
 #include "audit.h"
+#include "hashcache.h"
 #include "identifier.h"
 #include "info.h"
 #include "task.h"
@@ -92,7 +93,7 @@ public:
 	typedef std::shared_ptr<AuditTask> ptr;
 
 	// ctor
-	AuditTask(bool reportProgress, int cookie);
+	AuditTask(bool reportProgress, int cookie, HashCache::ptr hashCache = { }, bool quick = false);
 
 	// methods
 	const Audit &addMachineAudit(const Preferences &prefs, const info::machine &machine);
@@ -120,6 +121,8 @@ private:
 	std::vector<Entry>			m_entries;
 	std::optional<Throttler>	m_reportThrottler;
 	int							m_cookie;
+	HashCache::ptr				m_hashCache;
+	bool						m_quick;
 };
 
 #endif // AUDITTASK_H
@@ -144,6 +144,7 @@ namespace bindata
 			{
 				if (!m_db)
 					throw std::out_of_range("bindata::view::iterator::operator*");
+				m_db->ensureLoaded(*m_spanIter);
 				return TPublic(*m_db, *m_spanIter);
 			}
 				
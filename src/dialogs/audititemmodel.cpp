@@ -91,6 +91,10 @@ AuditStatus AuditItemModel::auditStatusFromVerdict(const std::optional<Audit::Ve
 			result = AuditStatus::Found;
 			break;
 
+		case Audit::Verdict::Type::OkMetadataVerified:
+			result = AuditStatus::FoundMetadataOnly;
+			break;
+
 		case Audit::Verdict::Type::NotFound:
 			result = optional ? AuditStatus::MissingOptional : AuditStatus::Missing;
 			break;
@@ -197,6 +201,10 @@ QVariant AuditItemModel::data(const QModelIndex &index, int role) const
 						result = "No Good Dump Known";
 						break;
 
+					case Audit::Verdict::Type::OkMetadataVerified:
+						result = "Ok (Archive Metadata Only)";
+						break;
+
 					case Audit::Verdict::Type::NotFound:
 						result = "Not Found";
 						break;
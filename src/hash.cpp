@@ -10,15 +10,518 @@
 #include "hash.h"
 
 // Qt headers
-#include <QCryptographicHash>
 #include <QIODevice>
 
+// standard headers
+#include <bit>
+#include <utility>
+#include <vector>
+
+// platform-specific headers
+#if defined(__x86_64__) || defined(_M_X64)
+#define HASH_X86_64		1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define HASH_ARM64		1
+#ifdef _MSC_VER
+#include <intrin.h>
+#include <arm64_neon.h>
+#else
+#include <arm_acle.h>
+#include <arm_neon.h>
+#endif
+#if defined(_WIN32)
+#include <windows.h>
+#elif defined(__linux__)
+#include <asm/hwcap.h>
+#include <sys/auxv.h>
+#elif defined(__APPLE__)
+#include <sys/sysctl.h>
+#endif
+#endif
+
 
 //**************************************************************************
-//  IMPLEMENTATION
+//  CONSTANTS
+//**************************************************************************
+
+// instruction set extensions need to be enabled per function on GCC and Clang
+#if defined(__GNUC__) || defined(__clang__)
+#define TARGET_PCLMUL	__attribute__((target("pclmul")))
+#define TARGET_SHANI	__attribute__((target("sha,ssse3,sse4.1")))
+#else
+#define TARGET_PCLMUL
+#define TARGET_SHANI
+#endif
+
+#if defined(__ARM_FEATURE_CRC32) || !defined(__clang__) && !defined(__GNUC__)
+#define TARGET_CRC
+#elif defined(__clang__)
+#define TARGET_CRC		__attribute__((target("crc")))
+#else
+#define TARGET_CRC		__attribute__((target("+crc")))
+#endif
+
+#if defined(__ARM_FEATURE_SHA2) || defined(__ARM_FEATURE_CRYPTO) || !defined(__clang__) && !defined(__GNUC__)
+#define TARGET_ARMSHA
+#elif defined(__clang__)
+#define TARGET_ARMSHA	__attribute__((target("crypto")))
+#else
+#define TARGET_ARMSHA	__attribute__((target("+crypto")))
+#endif
+
+// SHA-1 round constants
+static const std::uint32_t SHA1_K[4] = { 0x5A827999, 0x6ED9EBA1, 0x8F1BBCDC, 0xCA62C1D6 };
+
+// the size of the pieces that Hash::calculate() runs through CRC32 and then SHA-1; small enough
+// that the second pass reads from L1
+static const std::size_t FUSED_SLICE_SIZE = 4096;
+
+
+//**************************************************************************
+//  CRC32 ENGINES
+//**************************************************************************
+
+//-------------------------------------------------
+//  calculateCrc32Tables - table zero is the usual
+//	byte at a time table; table N holds the CRC of
+//	each byte followed by N zero bytes
+//-------------------------------------------------
+
+static constexpr std::array<std::array<std::uint32_t, 256>, 16> calculateCrc32Tables()
+{
+	std::array<std::array<std::uint32_t, 256>, 16> result = { };
+	for (std::uint32_t i = 0; i < 256; i++)
+	{
+		std::uint32_t crc = i;
+		for (int j = 0; j < 8; j++)
+			crc = crc & 1 ? (crc >> 1) ^ 0xEDB88320UL : crc >> 1;
+		result[0][i] = crc;
+	}
+	for (std::size_t table = 1; table < result.size(); table++)
+	{
+		for (std::size_t i = 0; i < 256; i++)
+			result[table][i] = (result[table - 1][i] >> 8) ^ result[0][result[table - 1][i] & 0xFF];
+	}
+	return result;
+}
+
+static constexpr std::array<std::array<std::uint32_t, 256>, 16> s_crcTables = calculateCrc32Tables();
+
+
+//-------------------------------------------------
+//  crc32Bytewise
+//-------------------------------------------------
+
+static std::uint32_t crc32Bytewise(std::uint32_t crc, const std::uint8_t *data, std::size_t size)
+{
+	for (std::size_t i = 0; i < size; i++)
+		crc = s_crcTables[0][(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+	return crc;
+}
+
+
+//-------------------------------------------------
+//  crc32SlicingBy16
+//-------------------------------------------------
+
+static std::uint32_t crc32SlicingBy16(std::uint32_t crc, const std::uint8_t *data, std::size_t size)
+{
+	const auto &t = s_crcTables;
+	for (; size >= 16; data += 16, size -= 16)
+	{
+		// the first four bytes absorb the CRC register; the rest are looked up directly
+		std::uint32_t a = crc ^ (data[0] | (data[1] << 8) | (data[2] << 16) | ((std::uint32_t)data[3] << 24));
+		crc = t[15][a & 0xFF] ^ t[14][(a >> 8) & 0xFF] ^ t[13][(a >> 16) & 0xFF] ^ t[12][a >> 24]
+			^ t[11][data[4]] ^ t[10][data[5]] ^ t[9][data[6]] ^ t[8][data[7]]
+			^ t[7][data[8]] ^ t[6][data[9]] ^ t[5][data[10]] ^ t[4][data[11]]
+			^ t[3][data[12]] ^ t[2][data[13]] ^ t[1][data[14]] ^ t[0][data[15]];
+	}
+	return crc32Bytewise(crc, data, size);
+}
+
+
+#if HASH_X86_64
+//-------------------------------------------------
+//  cpuid - returns EAX, EBX, ECX and EDX for a
+//	leaf, or zeroes if the leaf is not supported
+//-------------------------------------------------
+
+static std::array<std::uint32_t, 4> cpuid(std::uint32_t leaf)
+{
+	std::array<std::uint32_t, 4> result = { };
+#ifdef _MSC_VER
+	int info[4];
+	__cpuid(info, 0);
+	if ((std::uint32_t)info[0] >= leaf)
+	{
+		__cpuidex(info, (int)leaf, 0);
+		for (std::size_t i = 0; i < result.size(); i++)
+			result[i] = (std::uint32_t)info[i];
+	}
+#else
+	__get_cpuid_count(leaf, 0, &result[0], &result[1], &result[2], &result[3]);
+#endif
+	return result;
+}
+
+
+//-------------------------------------------------
+//  cpuSupportsPclmul
+//-------------------------------------------------
+
+static bool cpuSupportsPclmul()
+{
+	return (cpuid(1)[2] & (1 << 1)) != 0;
+}
+
+
+//-------------------------------------------------
+//  pclmulFold - folds x forward by the distance
+//	encoded in k, and adds next
+//-------------------------------------------------
+
+TARGET_PCLMUL static inline __m128i pclmulFold(__m128i x, __m128i next, __m128i k)
+{
+	__m128i lo = _mm_clmulepi64_si128(x, k, 0x00);
+	__m128i hi = _mm_clmulepi64_si128(x, k, 0x11);
+	return _mm_xor_si128(_mm_xor_si128(hi, next), lo);
+}
+
+
+//-------------------------------------------------
+//  crc32Pclmul - folds 64 bytes at a time with
+//	carry-less multiplication, as described in
+//	Intel's "Fast CRC Computation for Generic
+//	Polynomials Using PCLMULQDQ Instruction"
+//-------------------------------------------------
+
+TARGET_PCLMUL static std::uint32_t crc32Pclmul(std::uint32_t crc, const std::uint8_t *data, std::size_t size)
+{
+	// folding needs at least one 64 byte block, and works in 16 byte blocks
+	if (size < 64)
+		return crc32SlicingBy16(crc, data, size);
+	std::size_t remainder = size % 16;
+	size -= remainder;
+
+	// constants for the bit reflected domain (x^N mod P for the fold distances), and for
+	// the Barrett reduction
+	const __m128i k1k2 = _mm_set_epi64x(0x01C6E41596, 0x0154442BD4);
+	const __m128i k3k4 = _mm_set_epi64x(0x00CCAA009E, 0x01751997D0);
+	const __m128i k5k0 = _mm_set_epi64x(0x0000000000, 0x0163CD6124);
+	const __m128i poly = _mm_set_epi64x(0x01F7011641, 0x01DB710641);
+	const __m128i mask32 = _mm_setr_epi32(~0, 0, ~0, 0);
+
+	// load the first block, absorbing the CRC register
+	__m128i x1 = _mm_loadu_si128((const __m128i *)(data + 0x00));
+	__m128i x2 = _mm_loadu_si128((const __m128i *)(data + 0x10));
+	__m128i x3 = _mm_loadu_si128((const __m128i *)(data + 0x20));
+	__m128i x4 = _mm_loadu_si128((const __m128i *)(data + 0x30));
+	x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128((int)crc));
+	data += 64;
+	size -= 64;
+
+	// fold 64 byte blocks in parallel
+	for (; size >= 64; data += 64, size -= 64)
+	{
+		x1 = pclmulFold(x1, _mm_loadu_si128((const __m128i *)(data + 0x00)), k1k2);
+		x2 = pclmulFold(x2, _mm_loadu_si128((const __m128i *)(data + 0x10)), k1k2);
+		x3 = pclmulFold(x3, _mm_loadu_si128((const __m128i *)(data + 0x20)), k1k2);
+		x4 = pclmulFold(x4, _mm_loadu_si128((const __m128i *)(data + 0x30)), k1k2);
+	}
+
+	// fold the four lanes into one, and then any remaining 16 byte blocks into that
+	x1 = pclmulFold(x1, x2, k3k4);
+	x1 = pclmulFold(x1, x3, k3k4);
+	x1 = pclmulFold(x1, x4, k3k4);
+	for (; size >= 16; data += 16, size -= 16)
+		x1 = pclmulFold(x1, _mm_loadu_si128((const __m128i *)data), k3k4);
+
+	// fold 128 bits down to 64
+	x2 = _mm_clmulepi64_si128(x1, k3k4, 0x10);
+	x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+	x2 = _mm_srli_si128(x1, 4);
+	x1 = _mm_and_si128(x1, mask32);
+	x1 = _mm_clmulepi64_si128(x1, k5k0, 0x00);
+	x1 = _mm_xor_si128(x1, x2);
+
+	// Barrett reduction down to 32 bits
+	x2 = _mm_and_si128(x1, mask32);
+	x2 = _mm_clmulepi64_si128(x2, poly, 0x10);
+	x2 = _mm_and_si128(x2, mask32);
+	x2 = _mm_clmulepi64_si128(x2, poly, 0x00);
+	x1 = _mm_xor_si128(x1, x2);
+	crc = (std::uint32_t)_mm_cvtsi128_si32(_mm_srli_si128(x1, 4));
+
+	// and finish off whatever is left over
+	return crc32SlicingBy16(crc, data, remainder);
+}
+#endif // HASH_X86_64
+
+
+#if HASH_ARM64
+//-------------------------------------------------
+//  cpuSupportsArmv8Crc32
+//-------------------------------------------------
+
+static bool cpuSupportsArmv8Crc32()
+{
+#if defined(__ARM_FEATURE_CRC32)
+	return true;
+#elif defined(_WIN32)
+	return IsProcessorFeaturePresent(PF_ARM_V8_CRC32_INSTRUCTIONS_AVAILABLE);
+#elif defined(__linux__)
+	return (getauxval(AT_HWCAP) & HWCAP_CRC32) != 0;
+#elif defined(__APPLE__)
+	int value = 0;
+	size_t valueSize = sizeof(value);
+	return sysctlbyname("hw.optional.armv8_crc32", &value, &valueSize, nullptr, 0) == 0 && value != 0;
+#else
+	return false;
+#endif
+}
+
+
+//-------------------------------------------------
+//  crc32Armv8
+//-------------------------------------------------
+
+TARGET_CRC static std::uint32_t crc32Armv8(std::uint32_t crc, const std::uint8_t *data, std::size_t size)
+{
+	for (; size >= 8; data += 8, size -= 8)
+	{
+		std::uint64_t value;
+		memcpy(&value, data, sizeof(value));
+		crc = __crc32d(crc, value);
+	}
+	for (; size > 0; data++, size--)
+		crc = __crc32b(crc, *data);
+	return crc;
+}
+#endif // HASH_ARM64
+
+
+//**************************************************************************
+//  SHA-1 ENGINES
 //**************************************************************************
 
-std::array<quint32, 256> Hash::s_crcTable = calculateCrc32Table();
+//-------------------------------------------------
+//  sha1Scalar
+//-------------------------------------------------
+
+static void sha1Scalar(std::array<std::uint32_t, 5> &state, const std::uint8_t *data, std::size_t blockCount)
+{
+	for (; blockCount > 0; data += 64, blockCount--)
+	{
+		// expand the message schedule
+		std::uint32_t w[80];
+		for (int i = 0; i < 16; i++)
+			w[i] = ((std::uint32_t)data[i * 4 + 0] << 24) | (data[i * 4 + 1] << 16) | (data[i * 4 + 2] << 8) | data[i * 4 + 3];
+		for (int i = 16; i < 80; i++)
+			w[i] = std::rotl(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
+
+		// and do the rounds
+		auto [a, b, c, d, e] = state;
+		for (int i = 0; i < 80; i++)
+		{
+			std::uint32_t f;
+			if (i < 20)
+				f = (b & c) | (~b & d);
+			else if (i < 40 || i >= 60)
+				f = b ^ c ^ d;
+			else
+				f = (b & c) | (b & d) | (c & d);
+
+			std::uint32_t temp = std::rotl(a, 5) + f + e + SHA1_K[i / 20] + w[i];
+			e = d;
+			d = c;
+			c = std::rotl(b, 30);
+			b = a;
+			a = temp;
+		}
+		state[0] += a;
+		state[1] += b;
+		state[2] += c;
+		state[3] += d;
+		state[4] += e;
+	}
+}
+
+
+#if HASH_X86_64
+//-------------------------------------------------
+//  cpuSupportsShaNi
+//-------------------------------------------------
+
+static bool cpuSupportsShaNi()
+{
+	// SHA extensions, plus the SSSE3 and SSE4.1 instructions we use alongside them
+	std::uint32_t ecx = cpuid(1)[2];
+	return (cpuid(7)[1] & (1 << 29)) != 0
+		&& (ecx & (1 << 9)) != 0
+		&& (ecx & (1 << 19)) != 0;
+}
+
+
+//-------------------------------------------------
+//  shaNiRounds - four rounds of SHA-1, and the
+//	message schedule work that can overlap them;
+//	m[] holds the schedule for the next 16 rounds
+//-------------------------------------------------
+
+template<int G>
+TARGET_SHANI static inline void shaNiRounds(__m128i &abcd, __m128i (&e)[2], __m128i (&m)[4])
+{
+	if constexpr (G == 0)
+		e[0] = _mm_add_epi32(e[0], m[0]);
+	else
+		e[G % 2] = _mm_sha1nexte_epu32(e[G % 2], m[G % 4]);
+	e[(G + 1) % 2] = abcd;
+	abcd = _mm_sha1rnds4_epu32(abcd, e[G % 2], G / 5);
+
+	if constexpr (G >= 3 && G <= 18)
+		m[(G + 1) % 4] = _mm_sha1msg2_epu32(m[(G + 1) % 4], m[G % 4]);
+	if constexpr (G >= 1 && G <= 16)
+		m[(G + 3) % 4] = _mm_sha1msg1_epu32(m[(G + 3) % 4], m[G % 4]);
+	if constexpr (G >= 2 && G <= 17)
+		m[(G + 2) % 4] = _mm_xor_si128(m[(G + 2) % 4], m[G % 4]);
+}
+
+
+//-------------------------------------------------
+//  shaNiAllRounds
+//-------------------------------------------------
+
+template<int... G>
+TARGET_SHANI static inline void shaNiAllRounds(std::integer_sequence<int, G...>, __m128i &abcd, __m128i (&e)[2], __m128i (&m)[4])
+{
+	(shaNiRounds<G>(abcd, e, m), ...);
+}
+
+
+//-------------------------------------------------
+//  sha1ShaNi
+//-------------------------------------------------
+
+TARGET_SHANI static void sha1ShaNi(std::array<std::uint32_t, 5> &state, const std::uint8_t *data, std::size_t blockCount)
+{
+	// the instructions want A in the most significant lane, and E on its own
+	const __m128i byteSwap = _mm_set_epi64x(0x0001020304050607, 0x08090A0B0C0D0E0F);
+	__m128i abcd = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *)&state[0]), 0x1B);
+	__m128i e[2] = { _mm_set_epi32((int)state[4], 0, 0, 0), _mm_setzero_si128() };
+
+	for (; blockCount > 0; data += 64, blockCount--)
+	{
+		__m128i savedAbcd = abcd;
+		__m128i savedE = e[0];
+		__m128i m[4];
+		for (int i = 0; i < 4; i++)
+			m[i] = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(data + i * 16)), byteSwap);
+
+		shaNiAllRounds(std::make_integer_sequence<int, 20>(), abcd, e, m);
+
+		e[0] = _mm_sha1nexte_epu32(e[0], savedE);
+		abcd = _mm_add_epi32(abcd, savedAbcd);
+	}
+
+	_mm_storeu_si128((__m128i *)&state[0], _mm_shuffle_epi32(abcd, 0x1B));
+	state[4] = (std::uint32_t)_mm_extract_epi32(e[0], 3);
+}
+#endif // HASH_X86_64
+
+
+#if HASH_ARM64
+//-------------------------------------------------
+//  cpuSupportsArmv8Sha1
+//-------------------------------------------------
+
+static bool cpuSupportsArmv8Sha1()
+{
+#if defined(__ARM_FEATURE_SHA2) || defined(__ARM_FEATURE_CRYPTO)
+	return true;
+#elif defined(_WIN32)
+	return IsProcessorFeaturePresent(PF_ARM_V8_CRYPTO_INSTRUCTIONS_AVAILABLE);
+#elif defined(__linux__)
+	return (getauxval(AT_HWCAP) & HWCAP_SHA1) != 0;
+#elif defined(__APPLE__)
+	return true;
+#else
+	return false;
+#endif
+}
+
+
+//-------------------------------------------------
+//  armv8Sha1Rounds - four rounds of SHA-1, and the
+//	schedule for four rounds sixteen rounds later
+//-------------------------------------------------
+
+template<int G>
+TARGET_ARMSHA static inline void armv8Sha1Rounds(uint32x4_t &abcd, std::uint32_t &e, uint32x4_t (&m)[4])
+{
+	uint32x4_t wk = vaddq_u32(m[G % 4], vdupq_n_u32(SHA1_K[G / 5]));
+	std::uint32_t nextE = vsha1h_u32(vgetq_lane_u32(abcd, 0));
+	if constexpr (G / 5 == 0)
+		abcd = vsha1cq_u32(abcd, e, wk);
+	else if constexpr (G / 5 == 2)
+		abcd = vsha1mq_u32(abcd, e, wk);
+	else
+		abcd = vsha1pq_u32(abcd, e, wk);
+	e = nextE;
+
+	if constexpr (G < 16)
+		m[G % 4] = vsha1su1q_u32(vsha1su0q_u32(m[G % 4], m[(G + 1) % 4], m[(G + 2) % 4]), m[(G + 3) % 4]);
+}
+
+
+//-------------------------------------------------
+//  armv8Sha1AllRounds
+//-------------------------------------------------
+
+template<int... G>
+TARGET_ARMSHA static inline void armv8Sha1AllRounds(std::integer_sequence<int, G...>, uint32x4_t &abcd, std::uint32_t &e, uint32x4_t (&m)[4])
+{
+	(armv8Sha1Rounds<G>(abcd, e, m), ...);
+}
+
+
+//-------------------------------------------------
+//  sha1Armv8
+//-------------------------------------------------
+
+TARGET_ARMSHA static void sha1Armv8(std::array<std::uint32_t, 5> &state, const std::uint8_t *data, std::size_t blockCount)
+{
+	uint32x4_t abcd = vld1q_u32(&state[0]);
+	std::uint32_t e = state[4];
+
+	for (; blockCount > 0; data += 64, blockCount--)
+	{
+		uint32x4_t savedAbcd = abcd;
+		std::uint32_t savedE = e;
+		uint32x4_t m[4];
+		for (int i = 0; i < 4; i++)
+			m[i] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(data + i * 16)));
+
+		armv8Sha1AllRounds(std::make_integer_sequence<int, 20>(), abcd, e, m);
+
+		e += savedE;
+		abcd = vaddq_u32(abcd, savedAbcd);
+	}
+
+	vst1q_u32(&state[0], abcd);
+	state[4] = e;
+}
+#endif // HASH_ARM64
+
+
+//**************************************************************************
+//  IMPLEMENTATION
+//**************************************************************************
 
 //-------------------------------------------------
 //  ctor
@@ -35,50 +538,97 @@ Hash::Hash(std::optional<std::uint32_t> crc32, const QByteArray &sha1)
 
 
 //-------------------------------------------------
-//  calculate - calculates CRC32 and SHA-1
+//  calculate - calculates CRC32 and/or SHA-1; if
+//	neither is asked for, the stream is not read
 //-------------------------------------------------
 
-std::optional<Hash> Hash::calculate(QIODevice &stream, const CalculateCallback &callback)
+std::optional<Hash> Hash::calculate(QIODevice &stream, const CalculateCallback &callback, bool useCrc32, bool useSha1)
 {
 	// sanity check
 	if (!callback)
 		throw false;
 
+	std::optional<Hash> result;
+	if (useCrc32 && useSha1)
+	{
+		result = calculateSpecialized<true, true>(stream, callback);
+	}
+	else if (useCrc32)
+	{
+		result = calculateSpecialized<true, false>(stream, callback);
+	}
+	else if (useSha1)
+	{
+		result = calculateSpecialized<false, true>(stream, callback);
+	}
+	else
+	{
+		// nothing to calculate; only report progress
+		if (!callback(std::max(stream.size(), (qint64)0)))
+			result = Hash();
+	}
+	return result;
+}
+
+
+//-------------------------------------------------
+//  calculateSpecialized - the actual loop behind
+//	calculate(), instantiated for each combination
+//	of hashes so that unused ones cost nothing
+//-------------------------------------------------
+
+template<bool UseCrc32, bool UseSha1>
+std::optional<Hash> Hash::calculateSpecialized(QIODevice &stream, const CalculateCallback &callback)
+{
 	// setup
+	const Crc32Function updateCrc32 = UseCrc32 ? bestCrc32Function() : nullptr;
+	const Sha1Function updateSha1 = UseSha1 ? bestSha1Function() : nullptr;
 	std::uint32_t crc32 = ~0;
+	std::array<std::uint32_t, 5> sha1State = SHA1_INITIAL_STATE;
 	std::uint64_t bytesProcessed = 0;
 
-	// Qt has SHA-1 functionality
-	QCryptographicHash cryptographicHash(QCryptographicHash::Algorithm::Sha1);
+	// the buffer holds whole SHA-1 blocks, following whatever partial block was left over from
+	// the previous read
+	std::vector<std::uint8_t> buffer(65536);
+	std::size_t pendingSize = 0;
 
 	while (!stream.atEnd())
 	{
 		// read into a buffer
-		char buffer[15000];
-		int len = (int)stream.read(buffer, std::size(buffer));
+		qint64 len = stream.read((char *)&buffer[pendingSize], buffer.size() - pendingSize);
 		if (len <= 0)
 			break;
 		bytesProcessed += len;
 
-		// CRC32 processing
-		for (int i = 0; i < len; i++)
-			crc32 = s_crcTable[(crc32 ^ buffer[i]) & 0xFF] ^ (crc32 >> 8);
-
-		// SHA-1 processing
-#if QT_VERSION < 0x060300
-		cryptographicHash.addData(buffer, len);
-#else // !QT_VERSION < 0x060300
-		cryptographicHash.addData(QByteArrayView(buffer, len));
-#endif // QT_VERSION < 0x060300
+		// run whole blocks through CRC32 and SHA-1 a slice at a time, so that each slice is only
+		// fetched from memory once
+		std::size_t availableSize = pendingSize + (std::size_t)len;
+		std::size_t blocksSize = availableSize / 64 * 64;
+		for (std::size_t position = 0; position < blocksSize; position += FUSED_SLICE_SIZE)
+		{
+			std::size_t sliceSize = std::min(FUSED_SLICE_SIZE, blocksSize - position);
+			if constexpr (UseCrc32)
+				crc32 = updateCrc32(crc32, &buffer[position], sliceSize);
+			if constexpr (UseSha1)
+				updateSha1(sha1State, &buffer[position], sliceSize / 64);
+		}
+
+		// hold on to any partial block
+		pendingSize = availableSize - blocksSize;
+		memmove(&buffer[0], &buffer[blocksSize], pendingSize);
 
 		// invoke callback if appropriate
 		if (callback(bytesProcessed))
 			return { };
 	}
 
-	// we're done; return the right results
-	crc32 ^= ~0;
-	return Hash(crc32, cryptographicHash.result());
+	// finish off the partial block, and return the right results
+	Hash result;
+	if constexpr (UseCrc32)
+		result.m_crc32 = ~updateCrc32(crc32, &buffer[0], pendingSize);
+	if constexpr (UseSha1)
+		result.m_sha1 = finishSha1(sha1State, updateSha1, &buffer[0], pendingSize, bytesProcessed);
+	return result;
 }
 
 
@@ -126,23 +676,120 @@ QString Hash::hexString(const void *ptr, size_t sz)
 
 
 //-------------------------------------------------
-//  calculateCrc32Table
+//  crc32Function - returns the implementation of a
+//	CRC32 engine, or nullptr if this CPU (or build)
+//	does not support it
 //-------------------------------------------------
 
-std::array<quint32, 256> Hash::calculateCrc32Table()
+Hash::Crc32Function Hash::crc32Function(Crc32Engine engine)
 {
-	std::array<quint32, 256> result;
-
-	// initialize CRC table
-	for (int i = 0; i < std::size(result); i++)
+	switch (engine)
 	{
-		quint32 crc = i;
-		for (int j = 0; j < 8; j++)
-			crc = crc & 1 ? (crc >> 1) ^ 0xEDB88320UL : crc >> 1;
+	case Crc32Engine::Bytewise:
+		return crc32Bytewise;
+	case Crc32Engine::SlicingBy16:
+		return crc32SlicingBy16;
+#if HASH_X86_64
+	case Crc32Engine::Pclmul:
+		return cpuSupportsPclmul() ? crc32Pclmul : nullptr;
+#endif // HASH_X86_64
+#if HASH_ARM64
+	case Crc32Engine::Armv8:
+		return cpuSupportsArmv8Crc32() ? crc32Armv8 : nullptr;
+#endif // HASH_ARM64
+	default:
+		return nullptr;
+	}
+}
+
+
+//-------------------------------------------------
+//  sha1Function - returns the implementation of a
+//	SHA-1 engine, or nullptr if this CPU (or build)
+//	does not support it
+//-------------------------------------------------
 
-		result[i] = crc;
+Hash::Sha1Function Hash::sha1Function(Sha1Engine engine)
+{
+	switch (engine)
+	{
+	case Sha1Engine::Scalar:
+		return sha1Scalar;
+#if HASH_X86_64
+	case Sha1Engine::ShaNi:
+		return cpuSupportsShaNi() ? sha1ShaNi : nullptr;
+#endif // HASH_X86_64
+#if HASH_ARM64
+	case Sha1Engine::Armv8:
+		return cpuSupportsArmv8Sha1() ? sha1Armv8 : nullptr;
+#endif // HASH_ARM64
+	default:
+		return nullptr;
 	}
+}
+
+
+//-------------------------------------------------
+//  bestSha1Function
+//-------------------------------------------------
+
+Hash::Sha1Function Hash::bestSha1Function()
+{
+	static const Sha1Function result = []
+	{
+		for (Sha1Engine engine : { Sha1Engine::ShaNi, Sha1Engine::Armv8 })
+		{
+			if (Sha1Function function = sha1Function(engine))
+				return function;
+		}
+		return sha1Function(Sha1Engine::Scalar);
+	}();
+	return result;
+}
 
+
+//-------------------------------------------------
+//  finishSha1 - pads the final partial block and
+//	returns the digest
+//-------------------------------------------------
+
+std::array<std::uint8_t, 20> Hash::finishSha1(std::array<std::uint32_t, 5> &state, Sha1Function function, const std::uint8_t *data, std::size_t size, std::uint64_t totalSize)
+{
+	assert(size < 64);
+
+	// the padding is a one bit, zeroes and then the length in bits; this might spill into a second block
+	std::array<std::uint8_t, 128> blocks = { };
+	memcpy(&blocks[0], data, size);
+	blocks[size] = 0x80;
+	std::size_t blocksSize = size + 9 <= 64 ? 64 : 128;
+	std::uint64_t totalBits = totalSize * 8;
+	for (int i = 0; i < 8; i++)
+		blocks[blocksSize - 1 - i] = (std::uint8_t)(totalBits >> (i * 8));
+	function(state, &blocks[0], blocksSize / 64);
+
+	// the digest is the state in big endian order
+	std::array<std::uint8_t, 20> result;
+	for (std::size_t i = 0; i < result.size(); i++)
+		result[i] = (std::uint8_t)(state[i / 4] >> (24 - (i % 4) * 8));
+	return result;
+}
+
+
+//-------------------------------------------------
+//  bestCrc32Function
+//-------------------------------------------------
+
+Hash::Crc32Function Hash::bestCrc32Function()
+{
+	static const Crc32Function result = []
+	{
+		for (Crc32Engine engine : { Crc32Engine::Pclmul, Crc32Engine::Armv8 })
+		{
+			if (Crc32Function function = crc32Function(engine))
+				return function;
+		}
+		return crc32Function(Crc32Engine::SlicingBy16);
+	}();
 	return result;
 }
 
@@ -57,20 +57,46 @@ public:
 	Hash mask(bool useCrc32, bool useSha1) const;
 
 	// statics
-	static std::optional<Hash> calculate(QIODevice &stream, const CalculateCallback &callback);
+	static std::optional<Hash> calculate(QIODevice &stream, const CalculateCallback &callback, bool useCrc32 = true, bool useSha1 = true);
 
 	// accessors
 	const std::optional<std::uint32_t> &crc32() const			{ return m_crc32; }
 	const std::optional<std::array<uint8_t, 20>> &sha1() const	{ return m_sha1; }
 
 private:
-	// static variables
-	static std::array<quint32, 256>         s_crcTable;
+	// CRC32 implementations; calculate() uses the fastest one that the CPU supports
+	enum class Crc32Engine
+	{
+		Bytewise,		// the classic table driven loop; the reference for the others
+		SlicingBy16,	// portable fallback
+		Pclmul,			// x86-64 PCLMULQDQ folding
+		Armv8			// ARMv8 CRC32 instructions
+	};
+
+	// takes and returns the CRC register (i.e. - without the final inversion)
+	typedef std::uint32_t (*Crc32Function)(std::uint32_t crc, const std::uint8_t *data, std::size_t size);
+
+	// SHA-1 implementations; like CRC32, calculate() uses the fastest one that the CPU supports
+	enum class Sha1Engine
+	{
+		Scalar,			// portable fallback
+		ShaNi,			// x86-64 SHA extensions
+		Armv8			// ARMv8 cryptography extensions
+	};
+
+	// processes whole 64 byte blocks
+	typedef void (*Sha1Function)(std::array<std::uint32_t, 5> &state, const std::uint8_t *data, std::size_t blockCount);
+	static constexpr std::array<std::uint32_t, 5> SHA1_INITIAL_STATE = { 0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0 };
 
 	std::optional<std::uint32_t>			m_crc32;
 	std::optional<std::array<uint8_t, 20>>	m_sha1;
 
-	static std::array<quint32, 256> calculateCrc32Table();
+	static Crc32Function crc32Function(Crc32Engine engine);
+	static Crc32Function bestCrc32Function();
+	static Sha1Function sha1Function(Sha1Engine engine);
+	static Sha1Function bestSha1Function();
+	template<bool UseCrc32, bool UseSha1> static std::optional<Hash> calculateSpecialized(QIODevice &stream, const CalculateCallback &callback);
+	static std::array<std::uint8_t, 20> finishSha1(std::array<std::uint32_t, 5> &state, Sha1Function function, const std::uint8_t *data, std::size_t size, std::uint64_t totalSize);
 	static QString hexString(const void *ptr, size_t sz);
 };
 
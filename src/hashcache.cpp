@@ -0,0 +1,244 @@
+/***************************************************************************
+
+	hashcache.cpp
+
+	Persistent cache of asset hashes, so that audits need not re-read
+	assets that have not changed
+
+***************************************************************************/
+
+// bletchmame headers
+#include "hashcache.h"
+#include "perfprofiler.h"
+#include "utility.h"
+
+// Qt headers
+#include <QSaveFile>
+
+// standard headers
+#include <cstddef>
+
+
+//**************************************************************************
+//  IMPLEMENTATION
+//**************************************************************************
+
+//-------------------------------------------------
+//  ctor
+//-------------------------------------------------
+
+HashCache::HashCache(const QString &fileName)
+	: m_fileName(fileName)
+	, m_loaded(false)
+{
+}
+
+
+//-------------------------------------------------
+//  find - returns the cached hashes of an asset,
+//	provided that the ones asked for are there
+//-------------------------------------------------
+
+std::optional<Hash> HashCache::find(const AssetFinder::AssetInfo &assetInfo, bool useCrc32, bool useSha1)
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	ensureLoaded();
+
+	auto iter = m_hashes.find(makeKey(assetInfo));
+	if (iter == m_hashes.end()
+		|| (useCrc32 && !iter->second.crc32())
+		|| (useSha1 && !iter->second.sha1()))
+	{
+		return { };
+	}
+	return iter->second.mask(useCrc32, useSha1);
+}
+
+
+//-------------------------------------------------
+//  store - records the hashes of an asset (adding
+//	to whatever we already know about it)
+//-------------------------------------------------
+
+void HashCache::store(const AssetFinder::AssetInfo &assetInfo, const Hash &hash)
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	ensureLoaded();
+
+	// merge with what we already have
+	QByteArray key = makeKey(assetInfo);
+	Hash &cachedHash = m_hashes[key];
+	Hash newHash(
+		hash.crc32() ? hash.crc32() : cachedHash.crc32(),
+		hash.sha1() ? hash.sha1() : cachedHash.sha1());
+	if (newHash == cachedHash)
+		return;
+	cachedHash = newHash;
+
+	// and append a record; this is a single write so that we do not interleave with other writers
+	if (m_file.isOpen())
+		m_file.write(makeRecord(key, newHash));
+}
+
+
+//-------------------------------------------------
+//  ensureLoaded - loads the cache file on first
+//	use (called with the mutex held)
+//-------------------------------------------------
+
+void HashCache::ensureLoaded()
+{
+	if (m_loaded)
+		return;
+	m_loaded = true;
+
+	// without a file, we're just an in memory cache
+	if (m_fileName.isEmpty())
+		return;
+
+	// load what we have; if the file is not a hash cache (or does not exist) we start over, and if it
+	// is mostly superseded records we compact it
+	ProfilerScope prof(CURRENT_FUNCTION);
+	std::size_t recordCount;
+	if (!load(recordCount))
+	{
+		m_hashes.clear();
+		rewrite();
+	}
+	else if (recordCount > m_hashes.size() * 2 + 1000)
+	{
+		rewrite();
+	}
+
+	// and open the file for appending (failing to do so is not an error)
+	m_file.setFileName(m_fileName);
+	m_file.open(QIODevice::Append | QIODevice::Unbuffered);
+}
+
+
+//-------------------------------------------------
+//  load
+//-------------------------------------------------
+
+bool HashCache::load(std::size_t &recordCount)
+{
+	QFile file(m_fileName);
+	if (!file.open(QIODevice::ReadOnly))
+		return false;
+	QByteArray data = file.readAll();
+	file.close();
+
+	// check the header
+	Header header;
+	if (data.size() < sizeof(header))
+		return false;
+	memcpy(&header, data.constData(), sizeof(header));
+	if (header.m_magic != MAGIC)
+		return false;
+
+	// read records until we run out of valid ones
+	qsizetype position = sizeof(header);
+	recordCount = 0;
+	while (position + (qsizetype)sizeof(RecordHeader) <= data.size())
+	{
+		RecordHeader recordHeader;
+		memcpy(&recordHeader, data.constData() + position, sizeof(recordHeader));
+		qsizetype recordSize = sizeof(recordHeader) + recordHeader.m_keySize;
+		if (position + recordSize > data.size() || recordChecksum(data.mid(position, recordSize)) != recordHeader.m_checksum)
+			break;
+
+		// this record is valid; take it
+		m_hashes.insert_or_assign(
+			data.mid(position + sizeof(recordHeader), recordHeader.m_keySize),
+			Hash(
+				(recordHeader.m_flags & FLAG_CRC32) ? recordHeader.m_crc32 : std::optional<std::uint32_t>(),
+				(recordHeader.m_flags & FLAG_SHA1) ? recordHeader.m_sha1 : std::optional<std::array<std::uint8_t, 20>>()));
+		position += recordSize;
+		recordCount++;
+	}
+
+	// if we stopped short, whatever follows is most likely a write that was cut short; lop it off so
+	// that what we append from here on is readable
+	if (position < data.size())
+		QFile::resize(m_fileName, position);
+	return true;
+}
+
+
+//-------------------------------------------------
+//  rewrite - writes out a fresh file holding a
+//	single record for each key
+//-------------------------------------------------
+
+void HashCache::rewrite()
+{
+	QSaveFile file(m_fileName);
+	if (!file.open(QIODevice::WriteOnly))
+		return;
+
+	Header header = { MAGIC };
+	file.write((const char *)&header, sizeof(header));
+	for (const auto &[key, hash] : m_hashes)
+		file.write(makeRecord(key, hash));
+	file.commit();
+}
+
+
+//-------------------------------------------------
+//  makeKey - identifies the asset by where it is,
+//	and by the size and modification time of the
+//	file (or the archive that contains it)
+//-------------------------------------------------
+
+QByteArray HashCache::makeKey(const AssetFinder::AssetInfo &assetInfo)
+{
+	std::uint64_t size = assetInfo.m_size;
+	std::int64_t lastModified = assetInfo.m_lastModified.toMSecsSinceEpoch();
+
+	QByteArray result = assetInfo.m_path.toUtf8();
+	result += '\0';
+	result += assetInfo.m_member.toUtf8();
+	result += '\0';
+	result.append((const char *)&size, sizeof(size));
+	result.append((const char *)&lastModified, sizeof(lastModified));
+	return result;
+}
+
+
+//-------------------------------------------------
+//  makeRecord
+//-------------------------------------------------
+
+QByteArray HashCache::makeRecord(const QByteArray &key, const Hash &hash)
+{
+	RecordHeader recordHeader = { };
+	recordHeader.m_keySize = util::safe_static_cast<std::uint16_t>(key.size());
+	if (hash.crc32())
+	{
+		recordHeader.m_flags |= FLAG_CRC32;
+		recordHeader.m_crc32 = *hash.crc32();
+	}
+	if (hash.sha1())
+	{
+		recordHeader.m_flags |= FLAG_SHA1;
+		recordHeader.m_sha1 = *hash.sha1();
+	}
+
+	QByteArray result((const char *)&recordHeader, sizeof(recordHeader));
+	result += key;
+	recordHeader.m_checksum = recordChecksum(result);
+	memcpy(result.data(), &recordHeader, sizeof(recordHeader));
+	return result;
+}
+
+
+//-------------------------------------------------
+//  recordChecksum
+//-------------------------------------------------
+
+std::uint16_t HashCache::recordChecksum(QByteArray record)
+{
+	std::uint16_t zero = 0;
+	memcpy(record.data() + offsetof(RecordHeader, m_checksum), &zero, sizeof(zero));
+	return qChecksum(record);
+}
@@ -0,0 +1,82 @@
+/***************************************************************************
+
+	hashcache.h
+
+	Persistent cache of asset hashes, so that audits need not re-read
+	assets that have not changed
+
+***************************************************************************/
+
+#ifndef HASHCACHE_H
+#define HASHCACHE_H
+
+// bletchmame headers
+#include "assetfinder.h"
+#include "hash.h"
+
+// Qt headers
+#include <QByteArray>
+#include <QFile>
+
+// standard headers
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+
+// ======================> HashCache
+
+class HashCache
+{
+public:
+	typedef std::shared_ptr<HashCache> ptr;
+	class Test;
+
+	// ctor
+	HashCache(const QString &fileName = QString());
+	HashCache(const HashCache &) = delete;
+	HashCache(HashCache &&) = delete;
+
+	// methods; these can be called from multiple threads
+	std::optional<Hash> find(const AssetFinder::AssetInfo &assetInfo, bool useCrc32, bool useSha1);
+	void store(const AssetFinder::AssetInfo &assetInfo, const Hash &hash);
+
+private:
+	// the file format is a header followed by records, each of which is a RecordHeader followed by the
+	// key; records are only ever appended (a later record supersedes an earlier one with the same key)
+	// so that any number of writers can share the file
+	struct Header
+	{
+		std::uint64_t					m_magic;
+	};
+
+	struct RecordHeader
+	{
+		std::uint16_t					m_keySize;
+		std::uint16_t					m_checksum;		// of the whole record with this field zeroed; catches torn writes
+		std::uint8_t					m_flags;		// FLAG_xxx
+		std::uint8_t					m_reserved[3];
+		std::uint32_t					m_crc32;
+		std::array<std::uint8_t, 20>	m_sha1;
+	};
+
+	static const std::uint64_t MAGIC = 0x424D484153483031;		// BMHASH01
+	static const std::uint8_t FLAG_CRC32 = 0x01;
+	static const std::uint8_t FLAG_SHA1 = 0x02;
+
+	std::mutex								m_mutex;
+	QString									m_fileName;
+	bool									m_loaded;
+	std::unordered_map<QByteArray, Hash>	m_hashes;
+	QFile									m_file;			// open for appending once loaded
+
+	void ensureLoaded();
+	bool load(std::size_t &recordCount);
+	void rewrite();
+	static QByteArray makeKey(const AssetFinder::AssetInfo &assetInfo);
+	static QByteArray makeRecord(const QByteArray &key, const Hash &hash);
+	static std::uint16_t recordChecksum(QByteArray record);
+};
+
+
+#endif // HASHCACHE_H
@@ -11,21 +11,91 @@
 #include "xmlparser.h"
 
 // Qt headers
+#include <QDateTime>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QThread>
 #include <QUrl>
 
+// standard headers
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <future>
+
+
+//**************************************************************************
+//  TYPE DEFINITIONS
+//**************************************************************************
+
+// ======================> HistoryDatabase::Builder
+
+struct HistoryDatabase::Builder
+{
+	std::vector<std::u8string>								m_texts;
+	std::vector<std::pair<std::u8string, std::uint32_t>>	m_keys;		// keys and the indexes of their texts
+
+	bool parse(const std::function<bool(XmlParser &)> &parseFunc);
+	void append(Builder &&that);
+};
+
 
 //**************************************************************************
 //  MAIN IMPLEMENTATION
 //**************************************************************************
 
 //-------------------------------------------------
-//  load
+//  load - loads history.xml, using (and updating)
+//	the binary cache when one is specified
 //-------------------------------------------------
 
-bool HistoryDatabase::load(const QString &fileName)
+bool HistoryDatabase::load(const QString &fileName, const QString &cacheFileName)
 {
 	QFile file(fileName);
-	return file.open(QIODevice::ReadOnly) && load(file);
+	if (!file.open(QIODevice::ReadOnly))
+		return false;
+
+	// if the cache is up to date, we don't need to parse anything
+	std::uint64_t sourceSize = util::safe_static_cast<std::uint64_t>(file.size());
+	std::int64_t sourceModified = QFileInfo(file).lastModified().toMSecsSinceEpoch();
+	if (!cacheFileName.isEmpty() && loadCache(cacheFileName, sourceSize, sourceModified))
+		return true;
+
+	// history.xml is big; if we can map it, we can parse it in parallel
+	uchar *data = sourceSize > 0 ? file.map(0, file.size()) : nullptr;
+	bool success;
+	if (data)
+	{
+		std::span<const char> input((const char *)data, util::safe_static_cast<std::size_t>(sourceSize));
+		success = load(input, defaultChunkCount(input.size()));
+		file.unmap(data);
+	}
+	else
+	{
+		success = load(file);
+	}
+	if (!success)
+		return false;
+
+	// identify what we were built from, so that the cache can be validated next time
+	Header &header = *reinterpret_cast<Header *>(m_ownedData.data());
+	header.m_sourceSize = sourceSize;
+	header.m_sourceModified = sourceModified;
+	header.m_formatVersion = FORMAT_VERSION;
+
+	// and save the cache (failing to do so is not an error); we use QSaveFile so that the cache
+	// is replaced atomically, but the rename fails if anybody still has the previous cache mapped
+	// so the owner of any other HistoryDatabase needs to unmap() it first
+	if (!cacheFileName.isEmpty())
+	{
+		QSaveFile cacheFile(cacheFileName);
+		if (cacheFile.open(QIODevice::WriteOnly))
+		{
+			cacheFile.write((const char *)m_ownedData.data(), util::safe_static_cast<qint64>(m_ownedData.size()));
+			cacheFile.commit();
+		}
+	}
+	return true;
 }
 
 
@@ -37,9 +107,232 @@ bool HistoryDatabase::load(QIODevice &stream)
 {
 	// prepare to parse a big history.xml file...
 	clear();
-	m_texts.reserve(120000);	// version dated 2022-06-30 has 107956 entries
-	m_texts.reserve(170000);	// version dated 2022-06-30 has 160959 entries
+	Builder builder;
+	builder.m_texts.reserve(120000);	// version dated 2022-06-30 has 107956 entries
+	builder.m_texts.reserve(170000);	// version dated 2022-06-30 has 160959 entries
+
+	// and do the dirty work
+	bool success = builder.parse([&stream](XmlParser &xml) { return xml.parse(stream); });
+	if (success)
+		pack(std::move(builder));
+	return success;
+}
+
+
+//-------------------------------------------------
+//  load - parses history.xml out of memory by
+//	splitting it into chunks at <entry> boundaries
+//	and parsing each chunk on its own thread
+//-------------------------------------------------
+
+bool HistoryDatabase::load(std::span<const char> input, int chunkCount)
+{
+	clear();
+
+	// everything before the first entry (the XML declaration, the <history> start tag etc) is a
+	// prologue that each chunk needs in order to be a well formed document on its own
+	static const char epilogue[] = "</history>";
+	std::size_t firstEntry = findEntry(input, 0);
+	std::span<const char> prologue = input.first(firstEntry);
+
+	// identify where each chunk begins
+	std::vector<std::size_t> chunkStarts = { firstEntry };
+	for (int i = 1; i < chunkCount; i++)
+	{
+		std::size_t target = firstEntry + (input.size() - firstEntry) * i / chunkCount;
+		std::size_t chunkStart = findEntry(input, std::max(target, chunkStarts.back() + 1));
+		if (chunkStart >= input.size())
+			break;
+		chunkStarts.push_back(chunkStart);
+	}
+
+	// parse each chunk with its own XmlParser
+	std::vector<Builder> chunks(chunkStarts.size());
+	auto parseChunk = [&](std::size_t index)
+	{
+		bool isLast = index + 1 >= chunkStarts.size();
+		std::size_t chunkEnd = isLast ? input.size() : chunkStarts[index + 1];
+		std::array<std::span<const char>, 3> pieces =
+		{
+			prologue,
+			input.subspan(chunkStarts[index], chunkEnd - chunkStarts[index]),
+			isLast ? std::span<const char>() : std::span<const char>(epilogue, sizeof(epilogue) - 1)
+		};
+
+		Builder &chunk = chunks[index];
+		chunk.m_texts.reserve(170000 * pieces[1].size() / std::max(input.size(), (std::size_t)1));
+		return chunk.parse([&pieces](XmlParser &xml) { return xml.parseBytes(pieces); });
+	};
+	std::vector<std::future<bool>> futures;
+	for (std::size_t i = 1; i < chunks.size(); i++)
+		futures.push_back(std::async(std::launch::async, parseChunk, i));
+	bool success = parseChunk(0);
+	for (std::future<bool> &future : futures)
+		success = future.get() && success;
+
+	// the split is only a heuristic (an "<entry" in a comment would fool it), so if anything
+	// went wrong we start over with a single chunk to get the real error
+	if (!success && chunks.size() > 1)
+		return load(input, 1);
+	if (!success)
+		return false;
+
+	// merge the chunks in order, so that the results are identical to a sequential parse
+	Builder &builder = chunks[0];
+	for (std::size_t i = 1; i < chunks.size(); i++)
+		builder.append(std::move(chunks[i]));
+	pack(std::move(builder));
+	return true;
+}
+
+
+//-------------------------------------------------
+//  loadCache - maps the binary cache, if it was
+//	built from the specified source
+//-------------------------------------------------
+
+bool HistoryDatabase::loadCache(const QString &cacheFileName, std::uint64_t sourceSize, std::int64_t sourceModified)
+{
+	// open up the file; we need to keep it open for as long as the mapping lives
+	std::unique_ptr<QFile> file = std::make_unique<QFile>(cacheFileName);
+	if (!file->open(QIODevice::ReadOnly))
+		return false;
+
+	// map it
+	qint64 size = file->size();
+	const uchar *ptr = size >= (qint64)sizeof(Header) ? file->map(0, size) : nullptr;
+	if (!ptr)
+		return false;
+	std::span<const std::uint8_t> data(ptr, util::safe_static_cast<std::size_t>(size));
+
+	// is this cache for the file we were asked to load, and in the format that we expect?
+	Header header;
+	memcpy(&header, data.data(), sizeof(header));
+	if (header.m_sourceSize != sourceSize || header.m_sourceModified != sourceModified || header.m_formatVersion != FORMAT_VERSION)
+		return false;
+
+	// and attach to it
+	clear();
+	if (!attach(data))
+		return false;
+	m_mappedFile = std::move(file);
+	return true;
+}
+
+
+//-------------------------------------------------
+//  attach - points our views at data in the binary
+//	format, validating everything get() relies on
+//	(a cache file could be truncated or damaged)
+//-------------------------------------------------
+
+bool HistoryDatabase::attach(std::span<const std::uint8_t> data)
+{
+	// check the header
+	Header header;
+	if (data.size() < sizeof(header))
+		return false;
+	memcpy(&header, data.data(), sizeof(header));
+	if (header.m_magic != MAGIC)
+		return false;
+
+	// check the size
+	std::size_t textPositionsOffset = sizeof(Header);
+	std::size_t indexOffset = textPositionsOffset + ((std::size_t)header.m_textCount + 1) * sizeof(std::uint32_t);
+	std::size_t stringsOffset = indexOffset + (std::size_t)header.m_indexCount * sizeof(IndexEntry);
+	if (stringsOffset + header.m_stringsSize != data.size())
+		return false;
+
+	// set up the views
+	std::span<const std::uint32_t> textPositions((const std::uint32_t *)&data[textPositionsOffset], (std::size_t)header.m_textCount + 1);
+	std::span<const IndexEntry> index((const IndexEntry *)&data[indexOffset], header.m_indexCount);
+	std::u8string_view strings((const char8_t *)&data[stringsOffset], header.m_stringsSize);
+
+	// and validate them
+	if (!std::ranges::is_sorted(textPositions) || textPositions.back() > strings.size())
+		return false;
+	for (const IndexEntry &entry : index)
+	{
+		if (entry.m_textIndex >= header.m_textCount || (std::uint64_t)entry.m_keyPosition + entry.m_keyLength > strings.size())
+			return false;
+	}
+
+	m_textPositions = textPositions;
+	m_index = index;
+	m_strings = strings;
+	return true;
+}
+
+
+//-------------------------------------------------
+//  pack - converts what we parsed to the binary
+//	format
+//-------------------------------------------------
+
+void HistoryDatabase::pack(Builder &&builder)
+{
+	// sort the keys; the sort is stable so that the first of any duplicates wins
+	std::ranges::stable_sort(builder.m_keys, { }, [](const auto &pair) { return std::u8string_view(pair.first); });
+	auto [duplicatesBegin, duplicatesEnd] = std::ranges::unique(builder.m_keys, { }, [](const auto &pair) { return std::u8string_view(pair.first); });
+	builder.m_keys.erase(duplicatesBegin, duplicatesEnd);
+
+	// determine the layout
+	std::size_t stringsSize = 0;
+	for (const std::u8string &text : builder.m_texts)
+		stringsSize += text.size();
+	for (const auto &[key, textIndex] : builder.m_keys)
+		stringsSize += key.size();
+
+	Header header = { };
+	header.m_magic = MAGIC;
+	header.m_textCount = util::safe_static_cast<std::uint32_t>(builder.m_texts.size());
+	header.m_indexCount = util::safe_static_cast<std::uint32_t>(builder.m_keys.size());
+	header.m_stringsSize = util::safe_static_cast<std::uint32_t>(stringsSize);
+
+	std::size_t textPositionsOffset = sizeof(Header);
+	std::size_t indexOffset = textPositionsOffset + ((std::size_t)header.m_textCount + 1) * sizeof(std::uint32_t);
+	std::size_t stringsOffset = indexOffset + (std::size_t)header.m_indexCount * sizeof(IndexEntry);
+	std::vector<std::uint8_t> data(stringsOffset + stringsSize);
+	memcpy(&data[0], &header, sizeof(header));
+
+	// emit the texts, dropping each as we go
+	std::uint32_t *textPositions = (std::uint32_t *)&data[textPositionsOffset];
+	char8_t *strings = (char8_t *)&data[stringsOffset];
+	std::uint32_t position = 0;
+	for (std::u8string &text : builder.m_texts)
+	{
+		*textPositions++ = position;
+		std::ranges::copy(text, strings + position);
+		position += (std::uint32_t)text.size();
+		text = std::u8string();
+	}
+	*textPositions = position;
+
+	// and the index
+	IndexEntry *index = (IndexEntry *)&data[indexOffset];
+	for (const auto &[key, textIndex] : builder.m_keys)
+	{
+		*index++ = IndexEntry { position, (std::uint32_t)key.size(), textIndex };
+		std::ranges::copy(key, strings + position);
+		position += (std::uint32_t)key.size();
+	}
+
+	// finally attach to it
+	clear();
+	m_ownedData = std::move(data);
+	bool success = attach(m_ownedData);
+	assert(success);
+	(void)success;
+}
+
 
+//-------------------------------------------------
+//  Builder::parse - sets up an XmlParser to append
+//	entries to this builder, and invokes parseFunc
+//-------------------------------------------------
+
+bool HistoryDatabase::Builder::parse(const std::function<bool(XmlParser &)> &parseFunc)
+{
 	// set up the XML parser
 	XmlParser xml;
 	xml.onElementBegin({ "history", "entry" }, [this](const XmlParser::Attributes &)
@@ -50,27 +343,100 @@ bool HistoryDatabase::load(QIODevice &stream)
 	{
 		const auto [nameAttr] = attributes.get("name");
 		std::u8string_view name = nameAttr.as<std::u8string_view>().value_or(u8"");
-		m_lookup.insert({ MachineIdentifier(name), m_texts.size() - 1 });
+		m_keys.emplace_back(makeKey(name), util::safe_static_cast<std::uint32_t>(m_texts.size() - 1));
 	});
 	xml.onElementBegin({ "history", "entry", "software", "item" }, [this](const XmlParser::Attributes &attributes)
 	{
 		const auto [listAttr, nameAttr] = attributes.get("list", "name");
 		std::u8string_view list = listAttr.as<std::u8string_view>().value_or(u8"");
 		std::u8string_view name = nameAttr.as<std::u8string_view>().value_or(u8"");
-		m_lookup.insert({ SoftwareIdentifier(list, name), m_texts.size() - 1 });
+		m_keys.emplace_back(makeKey(list, name), util::safe_static_cast<std::uint32_t>(m_texts.size() - 1));
 	});
-	xml.onElementEnd({ "history", "entry", "text" }, [this](std::u8string &&content)
+	xml.onElementEnd({ "history", "entry", "text" }, [this](std::u8string_view content)
 	{
-		std::u8string_view trimmedContent = util::trim(content);
-		if (trimmedContent.size() != content.size())
-			content = trimmedContent;
-		util::last(m_texts) = std::move(content);
+		util::last(m_texts) = util::trim(content);
 	});
 
 	// and do the dirty work
-	bool success = xml.parse(stream);
-	m_texts.shrink_to_fit();
-	return success;
+	return parseFunc(xml);
+}
+
+
+//-------------------------------------------------
+//  Builder::append - moves the entries of another
+//	builder onto the end of this one
+//-------------------------------------------------
+
+void HistoryDatabase::Builder::append(Builder &&that)
+{
+	std::uint32_t offset = util::safe_static_cast<std::uint32_t>(m_texts.size());
+	m_texts.insert(m_texts.end(), std::make_move_iterator(that.m_texts.begin()), std::make_move_iterator(that.m_texts.end()));
+
+	m_keys.reserve(m_keys.size() + that.m_keys.size());
+	for (auto &[key, textIndex] : that.m_keys)
+		m_keys.emplace_back(std::move(key), textIndex + offset);
+
+	that.m_texts.clear();
+	that.m_keys.clear();
+}
+
+
+//-------------------------------------------------
+//  defaultChunkCount
+//-------------------------------------------------
+
+int HistoryDatabase::defaultChunkCount(std::size_t inputSize)
+{
+	// small files are not worth the threads
+	const std::size_t minimumChunkSize = 2 * 1024 * 1024;
+	std::size_t maximumChunkCount = std::max(inputSize / minimumChunkSize, (std::size_t)1);
+	int threadCount = std::clamp(QThread::idealThreadCount(), 1, 16);
+	return (int)std::min((std::size_t)threadCount, maximumChunkCount);
+}
+
+
+//-------------------------------------------------
+//  findEntry - finds the next <entry> start tag at
+//	or after position (or the end of input)
+//-------------------------------------------------
+
+std::size_t HistoryDatabase::findEntry(std::span<const char> input, std::size_t position)
+{
+	using namespace std::literals;
+	const std::string_view tag = "<entry"sv;
+	std::string_view text(input.data(), input.size());
+
+	for (position = text.find(tag, position); position != std::string_view::npos; position = text.find(tag, position + 1))
+	{
+		std::size_t next = position + tag.size();
+		if (next < text.size() && (isspace((unsigned char)text[next]) || text[next] == '>' || text[next] == '/'))
+			return position;
+	}
+	return input.size();
+}
+
+
+//-------------------------------------------------
+//  unmap - copies a memory mapped cache into memory
+//	that we own, so that the cache file can be
+//	replaced
+//-------------------------------------------------
+
+void HistoryDatabase::unmap()
+{
+	if (!m_mappedFile)
+		return;
+
+	// the views cover everything from the header to the end of the strings
+	const std::uint8_t *begin = (const std::uint8_t *)m_textPositions.data() - sizeof(Header);
+	const std::uint8_t *end = (const std::uint8_t *)(m_strings.data() + m_strings.size());
+	std::vector<std::uint8_t> data(begin, end);
+
+	clear();
+	m_ownedData = std::move(data);
+	bool success = attach(m_ownedData);
+	assert(success);
+	(void)success;
 }
 
 
@@ -80,24 +446,98 @@ bool HistoryDatabase::load(QIODevice &stream)
 
 void HistoryDatabase::clear()
 {
-	m_texts.clear();
-	m_lookup.clear();
+	m_textPositions = { };
+	m_index = { };
+	m_strings = { };
+	m_ownedData.clear();
+	m_mappedFile.reset();
 }
 
 
 //-------------------------------------------------
-//  get
+//  get - returns a view into the database (which,
+//	when loaded from the cache, is the mapping)
 //-------------------------------------------------
 
 std::u8string_view HistoryDatabase::get(const Identifier &identifier) const
 {
-	auto iter = m_lookup.find(identifier);
-	return iter != m_lookup.end()
-		? m_texts[iter->second]
+	std::u8string target = makeKey(identifier);
+	auto iter = std::ranges::lower_bound(m_index, std::u8string_view(target), { }, [this](const IndexEntry &entry)
+	{
+		return key(entry);
+	});
+	return iter != m_index.end() && key(*iter) == target
+		? text(iter->m_textIndex)
 		: std::u8string_view();
 }
 
 
+//-------------------------------------------------
+//  text
+//-------------------------------------------------
+
+std::u8string_view HistoryDatabase::text(std::uint32_t textIndex) const
+{
+	return m_strings.substr(m_textPositions[textIndex], m_textPositions[textIndex + 1] - m_textPositions[textIndex]);
+}
+
+
+//-------------------------------------------------
+//  key
+//-------------------------------------------------
+
+std::u8string_view HistoryDatabase::key(const IndexEntry &entry) const
+{
+	return m_strings.substr(entry.m_keyPosition, entry.m_keyLength);
+}
+
+
+//-------------------------------------------------
+//  makeKey - keys are the identifier's text with
+//	a prefix indicating its type (and a separator
+//	between software list and software)
+//-------------------------------------------------
+
+std::u8string HistoryDatabase::makeKey(const Identifier &identifier)
+{
+	return std::visit(util::overloaded
+	{
+		[](const MachineIdentifier &x) { return makeKey(x.machineName()); },
+		[](const SoftwareIdentifier &x) { return makeKey(x.softwareList(), x.software()); }
+	}, identifier);
+}
+
+
+//-------------------------------------------------
+//  makeKey
+//-------------------------------------------------
+
+std::u8string HistoryDatabase::makeKey(std::u8string_view machineName)
+{
+	std::u8string result;
+	result.reserve(machineName.size() + 1);
+	result += u8'm';
+	result += machineName;
+	return result;
+}
+
+
+//-------------------------------------------------
+//  makeKey
+//-------------------------------------------------
+
+std::u8string HistoryDatabase::makeKey(std::u8string_view softwareList, std::u8string_view software)
+{
+	std::u8string result;
+	result.reserve(softwareList.size() + software.size() + 2);
+	result += u8's';
+	result += softwareList;
+	result += u8'\0';
+	result += software;
+	return result;
+}
+
+
 //-------------------------------------------------
 //  getRichText
 //-------------------------------------------------
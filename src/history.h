@@ -15,11 +15,13 @@
 #include "identifier.h"
 
 // Qt headers
+#include <QFile>
 #include <QIODevice>
 
 // standard headers
+#include <memory>
+#include <span>
 #include <string>
-#include <unordered_map>
 #include <vector>
 
 
@@ -38,16 +40,56 @@ public:
 
 	HistoryDatabase &operator=(HistoryDatabase &&) = default;
 
-	bool load(const QString &fileName);
+	bool load(const QString &fileName, const QString &cacheFileName = QString());
+	void unmap();
 	void clear();
 	std::u8string_view get(const Identifier &identifier) const;
 	QString getRichText(const Identifier &identifier) const;
 
 private:
-	std::vector<std::u8string>					m_texts;
-	std::unordered_map<Identifier, std::size_t>	m_lookup;
+	struct Builder;
+
+	// the binary format, used both for the cache file and in memory; the header is followed by the
+	// text positions (one more than the text count), the index sorted by key and finally the strings
+	struct Header
+	{
+		std::uint64_t	m_magic;
+		std::uint64_t	m_sourceSize;
+		std::int64_t	m_sourceModified;	// msecs since epoch
+		std::uint32_t	m_textCount;
+		std::uint32_t	m_indexCount;
+		std::uint32_t	m_stringsSize;
+		std::uint32_t	m_formatVersion;	// bumped whenever the format or parsing changes
+	};
+
+	struct IndexEntry
+	{
+		std::uint32_t	m_keyPosition;		// within the strings
+		std::uint32_t	m_keyLength;
+		std::uint32_t	m_textIndex;
+	};
+
+	static const std::uint64_t MAGIC = 0x424D484953543031;		// BMHIST01
+	static const std::uint32_t FORMAT_VERSION = 1;
+
+	std::vector<std::uint8_t>			m_ownedData;		// populated when built from history.xml
+	std::unique_ptr<QFile>				m_mappedFile;		// populated when the cache is memory mapped
+	std::span<const std::uint32_t>		m_textPositions;
+	std::span<const IndexEntry>			m_index;
+	std::u8string_view					m_strings;
 
 	bool load(QIODevice &stream);
+	bool load(std::span<const char> input, int chunkCount);
+	bool loadCache(const QString &cacheFileName, std::uint64_t sourceSize, std::int64_t sourceModified);
+	bool attach(std::span<const std::uint8_t> data);
+	void pack(Builder &&builder);
+	std::u8string_view text(std::uint32_t textIndex) const;
+	std::u8string_view key(const IndexEntry &entry) const;
+	static std::u8string makeKey(const Identifier &identifier);
+	static std::u8string makeKey(std::u8string_view machineName);
+	static std::u8string makeKey(std::u8string_view softwareList, std::u8string_view software);
+	static int defaultChunkCount(std::size_t inputSize);
+	static std::size_t findEntry(std::span<const char> input, std::size_t position);
 	static QString toRichText(std::u8string_view text);
 };
 
@@ -23,7 +23,7 @@ class HistoryWatcher::LoadHistoryTask : public Task
 public:
 	typedef std::unique_ptr<LoadHistoryTask> ptr;
 
-	LoadHistoryTask(HistoryWatcher &host, const QString &path, bool retainIfFail);
+	LoadHistoryTask(HistoryWatcher &host, const QString &path, const QString &cachePath, bool retainIfFail);
 	~LoadHistoryTask();
 
 protected:
@@ -33,6 +33,7 @@ protected:
 private:
 	HistoryWatcher &		m_host;
 	QString					m_path;
+	QString					m_cachePath;
 	bool					m_retainIfFail;
 	HistoryDatabase::ptr	m_newDb;
 	std::optional<bool>		m_success;
@@ -76,7 +77,10 @@ HistoryWatcher::HistoryWatcher(Preferences &prefs, TaskDispatcher &taskDispatche
 
 void HistoryWatcher::startLoadHistoryTask(const QString &path, bool retainIfFail)
 {
-	LoadHistoryTask::ptr task = std::make_unique<LoadHistoryTask>(*this, path, retainIfFail);
+	// the task may rewrite the cache, which it cannot do while we have it mapped
+	m_db.unmap();
+
+	LoadHistoryTask::ptr task = std::make_unique<LoadHistoryTask>(*this, path, m_prefs.getHistoryCachePath(), retainIfFail);
 	m_taskDispatcher.launch(std::move(task));
 }
 
@@ -103,9 +107,10 @@ void HistoryWatcher::loadHistoryComplete(HistoryDatabase &&newDb, bool retainIfF
 //  LoadHistoryTask ctor
 //-------------------------------------------------
 
-HistoryWatcher::LoadHistoryTask::LoadHistoryTask(HistoryWatcher &host, const QString &path, bool retainIfFail)
+HistoryWatcher::LoadHistoryTask::LoadHistoryTask(HistoryWatcher &host, const QString &path, const QString &cachePath, bool retainIfFail)
 	: m_host(host)
 	, m_path(path)
+	, m_cachePath(cachePath)
 	, m_retainIfFail(retainIfFail)
 {
 }
@@ -129,7 +134,7 @@ HistoryWatcher::LoadHistoryTask::~LoadHistoryTask()
 
 void HistoryWatcher::LoadHistoryTask::run()
 {
-	// load the new history
+	// load the new history; this only parses history.xml if the cache is out of date
 	m_newDb = std::make_unique<HistoryDatabase>();
-	m_success = m_newDb->load(m_path);
+	m_success = m_newDb->load(m_path, m_cachePath);
 }
\ No newline at end of file
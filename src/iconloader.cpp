@@ -280,6 +280,7 @@ std::u8string_view IconLoader::getAdornmentForAuditStatus(AuditStatus machineAud
 		break;
 
 	case AuditStatus::Found:
+	case AuditStatus::FoundMetadataOnly:
 		result = u8""sv;
 		break;
 
@@ -18,6 +18,9 @@
 #include <cassert>
 #include <stdexcept>
 
+// dependency headers
+#include <zlib.h>
+
 
 //**************************************************************************
 //  ASSERTS
@@ -39,6 +42,10 @@ static_assert(std::ranges::random_access_range<info::configuration_setting::view
 static_assert(std::ranges::random_access_range<info::configuration_condition::view>);
 static_assert(std::ranges::random_access_range<info::software_list::view>);
 static_assert(std::ranges::random_access_range<info::ram_option::view>);
+static_assert(std::ranges::random_access_range<info::machine_group::view>);
+static_assert(std::ranges::random_access_range<info::machine_list>);
+static_assert(std::ranges::random_access_range<info::rom_by_crc::view>);
+static_assert(std::ranges::random_access_range<info::disk_by_sha1::view>);
 
 // and more asserts to ensure that we can use our views as C++20 sized_range
 static_assert(std::ranges::sized_range<info::machine::view>);
@@ -57,6 +64,10 @@ static_assert(std::ranges::sized_range<info::configuration_setting::view>);
 static_assert(std::ranges::sized_range<info::configuration_condition::view>);
 static_assert(std::ranges::sized_range<info::software_list::view>);
 static_assert(std::ranges::sized_range<info::ram_option::view>);
+static_assert(std::ranges::sized_range<info::machine_group::view>);
+static_assert(std::ranges::sized_range<info::machine_list>);
+static_assert(std::ranges::sized_range<info::rom_by_crc::view>);
+static_assert(std::ranges::sized_range<info::disk_by_sha1::view>);
 
 // and more asserts to ensure that we can use our views as C++20 borrowed_range
 static_assert(std::ranges::borrowed_range<info::machine::view>);
@@ -75,6 +86,10 @@ static_assert(std::ranges::borrowed_range<info::configuration_setting::view>);
 static_assert(std::ranges::borrowed_range<info::configuration_condition::view>);
 static_assert(std::ranges::borrowed_range<info::software_list::view>);
 static_assert(std::ranges::borrowed_range<info::ram_option::view>);
+static_assert(std::ranges::borrowed_range<info::machine_group::view>);
+static_assert(std::ranges::borrowed_range<info::machine_list>);
+static_assert(std::ranges::borrowed_range<info::rom_by_crc::view>);
+static_assert(std::ranges::borrowed_range<info::disk_by_sha1::view>);
 
 
 //**************************************************************************
@@ -168,12 +183,16 @@ bindata::view_position getPosition(size_t &cursor, std::uint32_t count) noexcept
 
 bool info::database::load(const QString &file_name, const QString &expected_version) noexcept
 {
-	// check for file existance
+	// try to memory map the file; this avoids copying the whole database and
+	// only pages in the tables that are actually touched
+	load_mapped_result mappedResult = loadMapped(file_name, expected_version);
+	if (mappedResult != load_mapped_result::COULD_NOT_MAP)
+		return mappedResult == load_mapped_result::SUCCESS;
+
+	// mapping is not possible; fall back to reading the file
 	QFile file(file_name);
 	if (!file.open(QIODevice::ReadOnly))
 		return false;
-
-	// open up the file
 	return load(file, expected_version);
 }
 
@@ -201,16 +220,95 @@ bool info::database::load(QIODevice &input, const QString &expected_version) noe
 
 	// try to load the data
 	binaries::header salted_hdr;
-	newState.m_data = load_data(input, salted_hdr);
-	if (newState.m_data.empty())
+	newState.m_ownedData = load_data(input, salted_hdr);
+	if (newState.m_ownedData.empty())
 		return false;
+	newState.m_data = newState.m_ownedData;
 
-	// unsalt the header
-	binaries::header hdr = util::salt(salted_hdr, info::binaries::salt());
+	// and process it
+	return loadState(std::move(newState), salted_hdr, expected_version);
+}
+
+
+//-------------------------------------------------
+//  database::loadMapped
+//-------------------------------------------------
+
+info::database::load_mapped_result info::database::loadMapped(const QString &file_name, const QString &expected_version) noexcept
+{
+	info::database::State newState;
+
+	// open up the file; we need to keep it open for as long as the mapping lives
+	newState.m_mappedFile = std::make_unique<QFile>(file_name);
+	if (!newState.m_mappedFile->open(QIODevice::ReadOnly))
+		return load_mapped_result::COULD_NOT_MAP;
+
+	// map it
+	qint64 size = newState.m_mappedFile->size();
+	if (size <= (qint64)sizeof(binaries::header))
+		return load_mapped_result::INVALID;
+	const uchar *ptr = newState.m_mappedFile->map(0, size);
+	if (!ptr)
+		return load_mapped_result::COULD_NOT_MAP;
+
+	// the header is copied out; everything else is referenced from the mapping
+	binaries::header salted_hdr;
+	memcpy(&salted_hdr, ptr, sizeof(salted_hdr));
+	newState.m_data = std::span<const std::uint8_t>(ptr + sizeof(salted_hdr), util::safe_static_cast<size_t>(size) - sizeof(salted_hdr));
+
+	// and process it; if this fails, reading the file instead would fail the same way
+	return loadState(std::move(newState), salted_hdr, expected_version)
+		? load_mapped_result::SUCCESS
+		: load_mapped_result::INVALID;
+}
 
-	// check the header
+
+//-------------------------------------------------
+//  database::read_header - reads and validates
+//	just the header of an info DB (used to size
+//	the next build based on the last one)
+//-------------------------------------------------
+
+std::optional<info::binaries::header> info::database::read_header(QIODevice &input) noexcept
+{
+	// read the header
+	binaries::header salted_hdr;
+	if (input.read((char *) &salted_hdr, sizeof(salted_hdr)) != sizeof(salted_hdr))
+		return { };
+
+	// unsalt and check it
+	return unsalt_header(salted_hdr);
+}
+
+
+//-------------------------------------------------
+//  database::unsalt_header - unsalts and validates
+//	a header; the salt includes the format version
+//	so a header written by any other version will
+//	not unsalt to the magic number
+//-------------------------------------------------
+
+std::optional<info::binaries::header> info::database::unsalt_header(const binaries::header &salted_hdr) noexcept
+{
+	binaries::header hdr = util::salt(salted_hdr, info::binaries::salt());
 	if ((hdr.m_magic != info::binaries::MAGIC_HDR) || (hdr.m_sizes_hash != calculate_sizes_hash()))
+		return { };
+
+	return hdr;
+}
+
+
+//-------------------------------------------------
+//  database::loadState
+//-------------------------------------------------
+
+bool info::database::loadState(State &&newState, const binaries::header &salted_hdr, const QString &expected_version) noexcept
+{
+	// unsalt and check the header
+	std::optional<binaries::header> unsalted_hdr = unsalt_header(salted_hdr);
+	if (!unsalted_hdr)
 		return false;
+	const binaries::header &hdr = *unsalted_hdr;
 
 	// positions
 	size_t cursor = 0;
@@ -222,18 +320,33 @@ bool info::database::load(QIODevice &input, const QString &expected_version) noe
 	newState.m_slots_position						= getPosition<binaries::slot>(cursor, hdr.m_slots_count);
 	newState.m_slot_options_position				= getPosition<binaries::slot_option>(cursor, hdr.m_slot_options_count);
 	newState.m_features_position					= getPosition<binaries::feature>(cursor, hdr.m_features_count);
-	newState.m_chips_position						= getPosition<binaries::chip>(cursor, hdr.m_chips_count);
-	newState.m_displays_position					= getPosition<binaries::display>(cursor, hdr.m_displays_count);
+	newState.m_chips_position						= bindata::view_position(0, hdr.m_chips_count);
+	newState.m_displays_position					= bindata::view_position(0, hdr.m_displays_count);
 	newState.m_samples_position						= getPosition<binaries::sample>(cursor, hdr.m_samples_count);
-	newState.m_configurations_position				= getPosition<binaries::configuration>(cursor, hdr.m_configurations_count);
-	newState.m_configuration_settings_position		= getPosition<binaries::configuration_setting>(cursor, hdr.m_configuration_settings_count);
-	newState.m_configuration_conditions_position	= getPosition<binaries::configuration_condition>(cursor, hdr.m_configuration_conditions_count);
+	newState.m_configurations_position				= bindata::view_position(0, hdr.m_configurations_count);
+	newState.m_configuration_settings_position		= bindata::view_position(0, hdr.m_configuration_settings_count);
+	newState.m_configuration_conditions_position	= bindata::view_position(0, hdr.m_configuration_conditions_count);
 	newState.m_software_lists_position				= getPosition<binaries::software_list>(cursor, hdr.m_software_lists_count);
 	newState.m_ram_options_position					= getPosition<binaries::ram_option>(cursor, hdr.m_ram_options_count);
+	newState.m_machine_name_buckets_position		= getPosition<std::uint32_t>(cursor, hdr.m_machine_name_buckets_count);
+	newState.m_machine_name_slots_position			= getPosition<std::uint32_t>(cursor, hdr.m_machines_count);
+	newState.m_manufacturer_groups_position			= getPosition<binaries::machine_group>(cursor, hdr.m_manufacturer_groups_count);
+	newState.m_year_groups_position					= getPosition<binaries::machine_group>(cursor, hdr.m_year_groups_count);
+	newState.m_sourcefile_groups_position			= getPosition<binaries::machine_group>(cursor, hdr.m_sourcefile_groups_count);
+	newState.m_cpu_groups_position					= getPosition<binaries::machine_group>(cursor, hdr.m_cpu_groups_count);
+	newState.m_sound_groups_position				= getPosition<binaries::machine_group>(cursor, hdr.m_sound_groups_count);
+	newState.m_bios_groups_position					= getPosition<binaries::machine_group>(cursor, hdr.m_bios_groups_count);
+	newState.m_machine_references_position			= getPosition<binaries::machine_reference>(cursor, hdr.m_machine_references_count);
+	newState.m_roms_by_crc_position					= getPosition<binaries::rom_by_crc>(cursor, hdr.m_roms_by_crc_count);
+	newState.m_disks_by_sha1_position				= getPosition<binaries::disk_by_sha1>(cursor, hdr.m_disks_by_sha1_count);
+	newState.m_devices_by_tag_position				= getPosition<std::uint32_t>(cursor, hdr.m_devices_count);
+	newState.m_chips_by_name_position				= getPosition<std::uint32_t>(cursor, hdr.m_chips_count);
+	bindata::view_position compressedBlocksPosition	= getPosition<binaries::compressed_block>(cursor, hdr.m_compressed_blocks_count);
+	bindata::view_position compressedDataPosition	= getPosition<std::uint8_t>(cursor, hdr.m_compressed_data_size);
 	newState.m_string_table_offset					= static_cast<std::uint32_t>(cursor);
 
 	// sanity check the string table
-	if (newState.m_data.size() < (size_t)newState.m_string_table_offset + 1)
+	if (newState.m_data.size() < (size_t)newState.m_string_table_offset + sizeof(binaries::MAGIC_STRINGTABLE_BEGIN) + sizeof(binaries::MAGIC_STRINGTABLE_END) + 1)
 		return false;
 	if (!unaligned_check(&newState.m_data[(size_t)newState.m_string_table_offset], binaries::MAGIC_STRINGTABLE_BEGIN))
 		return false;
@@ -244,6 +357,19 @@ bool info::database::load(QIODevice &input, const QString &expected_version) noe
 	if (newState.m_string_table_offset != cursor)
 		return false;
 
+	// set up the cold tables; these are decompressed lazily
+	std::optional<std::span<const binaries::compressed_block>> compressedBlocks = tryGetDataSpan<binaries::compressed_block>(newState, compressedBlocksPosition.offset(), compressedBlocksPosition.count());
+	std::optional<std::span<const std::uint8_t>> compressedData = tryGetDataSpan<std::uint8_t>(newState, compressedDataPosition.offset(), compressedDataPosition.count());
+	if (!compressedBlocks || !compressedData)
+		return false;
+	if (!loadColdTable<binaries::chip>(newState, *compressedBlocks, *compressedData, hdr.m_chips_count)
+		|| !loadColdTable<binaries::display>(newState, *compressedBlocks, *compressedData, hdr.m_displays_count)
+		|| !loadColdTable<binaries::configuration>(newState, *compressedBlocks, *compressedData, hdr.m_configurations_count)
+		|| !loadColdTable<binaries::configuration_setting>(newState, *compressedBlocks, *compressedData, hdr.m_configuration_settings_count)
+		|| !loadColdTable<binaries::configuration_condition>(newState, *compressedBlocks, *compressedData, hdr.m_configuration_conditions_count)
+		|| !compressedBlocks->empty())
+		return false;
+
 	// version check if appropriate
 	std::optional<std::span<const char>> buildVersion = tryGetDataSpan<char>(newState, newState.m_string_table_offset + hdr.m_build_strindex);
 	if (!buildVersion)
@@ -251,8 +377,8 @@ bool info::database::load(QIODevice &input, const QString &expected_version) noe
 	if (!expected_version.isEmpty() && expected_version != tryGetQStringFromCharSpan(*buildVersion))
 		return false;
 
-	// finally things look good - first shrink the data array to drop the ending magic bytes
-	newState.m_data.resize(newState.m_data.size() - sizeof(binaries::MAGIC_STRINGTABLE_END));
+	// finally things look good - first shrink the data span to drop the ending magic bytes
+	newState.m_data = newState.m_data.first(newState.m_data.size() - sizeof(binaries::MAGIC_STRINGTABLE_END));
 
 	// ...set the state
 	m_state = std::move(newState);
@@ -267,6 +393,22 @@ bool info::database::load(QIODevice &input, const QString &expected_version) noe
 }
 
 
+//-------------------------------------------------
+//  database::loadColdTable
+//-------------------------------------------------
+
+template<typename T>
+bool info::database::loadColdTable(State &state, std::span<const binaries::compressed_block> &blocks, std::span<const std::uint8_t> compressedData, std::uint32_t count) noexcept
+{
+	std::unique_ptr<ColdTable> coldTable = ColdTable::create(blocks, compressedData, sizeof(T), count);
+	if (!coldTable)
+		return false;
+
+	state.m_coldTables[coldTableIndex<T>()] = std::move(coldTable);
+	return true;
+}
+
+
 //-------------------------------------------------
 //  database::calculate_sizes_hash
 //-------------------------------------------------
@@ -291,7 +433,12 @@ uint64_t info::database::calculate_sizes_hash() noexcept
 		sizeof(info::binaries::configuration_setting),
 		sizeof(info::binaries::configuration_condition),
 		sizeof(info::binaries::software_list),
-		sizeof(info::binaries::ram_option)
+		sizeof(info::binaries::ram_option),
+		sizeof(info::binaries::machine_group),
+		sizeof(info::binaries::machine_reference),
+		sizeof(info::binaries::rom_by_crc),
+		sizeof(info::binaries::disk_by_sha1),
+		sizeof(info::binaries::compressed_block)
 	};
 
 	uint64_t result = 0;
@@ -345,9 +492,9 @@ void info::database::onChanged() noexcept
 const QString &info::database::get_string(std::uint32_t offset) const noexcept
 {
 	// do we have this string in our loaded string cache?
-	auto iter = m_loaded_strings.find(offset);
-	if (iter != m_loaded_strings.end())
-		return iter->second;
+	const QString *cachedString = m_loaded_strings.find(offset);
+	if (cachedString)
+		return *cachedString;
 
 	QString string;
 	std::optional<std::array<char8_t, 6>> smallString = tryDecodeAsSmallString(offset);
@@ -363,11 +510,75 @@ const QString &info::database::get_string(std::uint32_t offset) const noexcept
 		string = getQStringFromCharSpan(utf8String);
 	}
 
-	// deposit this image in our cache
-	m_loaded_strings.emplace(offset, std::move(string));
+	// deposit this image in our cache and return a reference out of our cache; if
+	// another thread beat us to it, we get their string
+	return m_loaded_strings.emplace(offset, std::move(string));
+}
+
 
-	// and return a reference out of our cache
-	return m_loaded_strings.find(offset)->second;
+//-------------------------------------------------
+//  database::get_machine_index
+//-------------------------------------------------
+
+std::uint32_t info::database::get_machine_index(const binaries::machine &machine) const noexcept
+{
+	std::span<const binaries::machine> machines = getDataSpan<binaries::machine>(m_state.m_machines_position.offset(), m_state.m_machines_position.count());
+	assert(&machine >= machines.data() && &machine < machines.data() + machines.size());
+	return util::safe_static_cast<std::uint32_t>(&machine - machines.data());
+}
+
+
+//-------------------------------------------------
+//  database::find_device_index
+//-------------------------------------------------
+
+std::optional<std::uint32_t> info::database::find_device_index(std::uint32_t devices_index, std::uint32_t devices_count, std::u8string_view tag) const noexcept
+{
+	return find_sorted<binaries::device>(m_state.m_devices_position, m_state.m_devices_by_tag_position, devices_index, devices_count, tag,
+		[](const binaries::device &device) { return device.m_tag_strindex; });
+}
+
+
+//-------------------------------------------------
+//  database::find_chip_index
+//-------------------------------------------------
+
+std::optional<std::uint32_t> info::database::find_chip_index(std::uint32_t chips_index, std::uint32_t chips_count, std::u8string_view chip_name) const noexcept
+{
+	return find_sorted<binaries::chip>(m_state.m_chips_position, m_state.m_chips_by_name_position, chips_index, chips_count, chip_name,
+		[](const binaries::chip &chip) { return chip.m_name_strindex; });
+}
+
+
+//-------------------------------------------------
+//  database::find_sorted - binary searches a range
+//	of items (typically belonging to a machine)
+//	using an index sorted by a string on the item
+//-------------------------------------------------
+
+template<typename T, typename TFunc>
+std::optional<std::uint32_t> info::database::find_sorted(const bindata::view_position &items_position, const bindata::view_position &sorted_position,
+	std::uint32_t index, std::uint32_t count, std::u8string_view s, TFunc strindexFunc) const noexcept
+{
+	std::span<const T> items = getDataSpan<T>(items_position.offset(), items_position.count());
+	std::span<const std::uint32_t> sorted = getDataSpan<std::uint32_t>(sorted_position.offset(), sorted_position.count()).subspan(index, count);
+
+	// helper to get the string index for an item
+	auto getStrIndex = [this, &items, &strindexFunc](std::uint32_t itemIndex)
+	{
+		const T &item = items[itemIndex];
+		ensureLoaded(item);
+		return strindexFunc(item);
+	};
+
+	// find the first item not less than what we are looking for, and check for equality
+	auto iter = std::lower_bound(sorted.begin(), sorted.end(), s, [this, &getStrIndex](std::uint32_t itemIndex, std::u8string_view s)
+	{
+		return string_compare(getStrIndex(itemIndex), s) < 0;
+	});
+	return iter != sorted.end() && string_equals(getStrIndex(*iter), s)
+		? *iter
+		: std::optional<std::uint32_t>();
 }
 
 
@@ -445,14 +656,20 @@ std::optional<std::array<char8_t, 6>> info::database::tryDecodeAsSmallString(std
 
 std::optional<info::device> info::machine::find_device(const QString &tag) const noexcept
 {
-	// find the device
-	auto iter = std::ranges::find_if(
-		devices(),
-		[&tag](info::device dev) { return tag == dev.tag(); });
+	QByteArray tagUtf8 = tag.toUtf8();
+	return find_device(std::u8string_view((const char8_t *)tagUtf8.constData(), (size_t)tagUtf8.size()));
+}
 
-	// if we found a device, return the interface
-	return iter != devices().cend()
-		? *iter
+
+//-------------------------------------------------
+//  machine::find_device
+//-------------------------------------------------
+
+std::optional<info::device> info::machine::find_device(std::u8string_view tag) const noexcept
+{
+	std::optional<std::uint32_t> index = db().find_device_index(inner().m_devices_index, inner().m_devices_count, tag);
+	return index
+		? db().devices()[*index]
 		: std::optional<info::device>();
 }
 
@@ -463,14 +680,20 @@ std::optional<info::device> info::machine::find_device(const QString &tag) const
 
 std::optional<info::chip> info::machine::find_chip(const QString &chipName) const noexcept
 {
-	// find the device
-	auto iter = std::ranges::find_if(
-		chips(),
-		[&chipName](info::chip chip) { return chipName == chip.name(); });
+	QByteArray chipNameUtf8 = chipName.toUtf8();
+	return find_chip(std::u8string_view((const char8_t *)chipNameUtf8.constData(), (size_t)chipNameUtf8.size()));
+}
 
-	// if we found a device, return the interface
-	return iter != chips().cend()
-		? *iter
+
+//-------------------------------------------------
+//  machine::find_chip
+//-------------------------------------------------
+
+std::optional<info::chip> info::machine::find_chip(std::u8string_view chipName) const noexcept
+{
+	std::optional<std::uint32_t> index = db().find_chip_index(inner().m_chips_index, inner().m_chips_count, chipName);
+	return index
+		? db().chips()[*index]
 		: std::optional<info::chip>();
 }
 
@@ -499,14 +722,104 @@ std::optional<info::machine> info::machine::rom_of() const noexcept
 }
 
 
+//-------------------------------------------------
+//  machine_group::contains
+//-------------------------------------------------
+
+bool info::machine_group::contains(const info::machine &machine) const noexcept
+{
+	// machine lists are sorted by machine index, so we can binary search
+	std::uint32_t machineIndex = machine.index();
+	machine_list list = machines();
+	auto iter = std::ranges::lower_bound(list, machineIndex, { }, [](const info::machine &x) { return x.index(); });
+	return iter != list.end() && iter->index() == machineIndex;
+}
+
+
 //-------------------------------------------------
 //  slot_option::machine
 //-------------------------------------------------
 
 std::optional<info::machine> info::slot_option::machine() const noexcept
 {
-	return db().find_machine(devname());
+	// the device name was resolved to a machine index when the info DB was built
+	return inner().m_devname_machindex < db().machines().size()
+		? db().machines()[inner().m_devname_machindex]
+		: std::optional<info::machine>();
+}
+
+
+//-------------------------------------------------
+//  database::machine_name_hash - used for the
+//	machine name perfect hash; database_builder
+//	needs to agree with this
+//-------------------------------------------------
+
+std::uint32_t info::database::machine_name_hash(std::u8string_view s, std::uint32_t seed) noexcept
+{
+	// FNV-1a...
+	std::uint32_t result = 2166136261u ^ (seed * 0x9E3779B9u);
+	for (char8_t ch : s)
+	{
+		result ^= ch;
+		result *= 16777619u;
+	}
 
+	// ...followed by a final avalanche so that different seeds behave independently
+	result ^= result >> 16;
+	result *= 0x85EBCA6Bu;
+	result ^= result >> 13;
+	result *= 0xC2B2AE35u;
+	result ^= result >> 16;
+	return result;
+}
+
+
+//-------------------------------------------------
+//  database::string_compare - compares a string
+//	in the string table without decoding it
+//-------------------------------------------------
+
+std::strong_ordering info::database::string_compare(std::uint32_t strindex, std::u8string_view s) const noexcept
+{
+	std::u8string_view text;
+	std::optional<std::array<char8_t, 6>> smallString = tryDecodeAsSmallString(strindex);
+	if (smallString)
+	{
+		// this was a small string
+		text = std::u8string_view(smallString->data());
+	}
+	else
+	{
+		// perform a string table lookup
+		std::optional<std::span<const char>> span = tryGetDataSpan<char>(m_state, (size_t)m_state.m_string_table_offset + strindex);
+		if (span)
+			text = std::u8string_view((const char8_t *)span->data(), strnlen(span->data(), span->size()));
+	}
+	return text <=> s;
+}
+
+
+//-------------------------------------------------
+//  database::string_equals - checks a string in
+//	the string table for equality without decoding it
+//-------------------------------------------------
+
+bool info::database::string_equals(std::uint32_t strindex, std::u8string_view s) const noexcept
+{
+	// if this can be encoded as a small string, it always will be
+	std::optional<std::uint32_t> smallString = tryEncodeAsSmallString(s);
+	if (smallString)
+		return strindex == *smallString;
+	if ((strindex & 0xC0000000) == 0xC0000000)
+		return false;
+
+	// compare against the string table
+	std::optional<std::span<const char>> text = tryGetDataSpan<char>(m_state, (size_t)m_state.m_string_table_offset + strindex);
+	return text
+		&& text->size() > s.size()
+		&& !memcmp(text->data(), s.data(), s.size())
+		&& (*text)[s.size()] == '\0';
 }
 
 
@@ -514,19 +827,28 @@ std::optional<info::machine> info::slot_option::machine() const noexcept
 //  database::find_machine_index
 //-------------------------------------------------
 
-std::optional<int> info::database::find_machine_index(const QString &machine_name) const noexcept
+std::optional<std::uint32_t> info::database::find_machine_index(std::u8string_view machine_name) const noexcept
 {
-	auto iter = std::lower_bound(
-		machines().begin(),
-		machines().end(),
-		machine_name,
-		[](const info::machine &a, const QString &b)
-		{
-			return a.name() < b;
-		});
-	return iter != machines().end() && iter->name() == machine_name
-		? util::safe_static_cast<int>(iter - machines().begin())
-		: std::optional<int>();
+	std::span<const std::uint32_t> buckets = getDataSpan<std::uint32_t>(m_state.m_machine_name_buckets_position.offset(), m_state.m_machine_name_buckets_position.count());
+	std::span<const std::uint32_t> slots = getDataSpan<std::uint32_t>(m_state.m_machine_name_slots_position.offset(), m_state.m_machine_name_slots_position.count());
+	std::span<const binaries::machine> machines = getDataSpan<binaries::machine>(m_state.m_machines_position.offset(), m_state.m_machines_position.count());
+	if (buckets.empty() || slots.empty())
+		return { };
+
+	// find the bucket; singleton buckets point directly at the slot, otherwise they
+	// have the seed that will get us to the slot
+	std::uint32_t bucket = buckets[machine_name_hash(machine_name, 0) % buckets.size()];
+	std::uint32_t slot = (bucket & 0x80000000)
+		? bucket & ~0x80000000
+		: machine_name_hash(machine_name, bucket) % slots.size();
+	if (slot >= slots.size())
+		return { };
+
+	// and the slot has the machine index; we need to confirm that the name matches
+	std::uint32_t machineIndex = slots[slot];
+	return machineIndex < machines.size() && string_equals(machines[machineIndex].m_name_strindex, machine_name)
+		? machineIndex
+		: std::optional<std::uint32_t>();
 }
 
 
@@ -536,10 +858,8 @@ std::optional<int> info::database::find_machine_index(const QString &machine_nam
 
 std::optional<info::machine> info::database::find_machine(const QString &machine_name) const noexcept
 {
-	std::optional<int> index = find_machine_index(machine_name);
-	return index
-		? machines()[util::safe_static_cast<size_t>(*index)]
-		: std::optional<info::machine>();
+	QByteArray machineNameUtf8 = machine_name.toUtf8();
+	return find_machine(std::u8string_view((const char8_t *)machineNameUtf8.constData(), machineNameUtf8.size()));
 }
 
 
@@ -549,8 +869,227 @@ std::optional<info::machine> info::database::find_machine(const QString &machine
 
 std::optional<info::machine> info::database::find_machine(std::u8string_view machine_name) const noexcept
 {
-	QString machineNameQString = util::toQString(machine_name);
-	return find_machine(machineNameQString);
+	std::optional<std::uint32_t> index = find_machine_index(machine_name);
+	return index
+		? machines()[*index]
+		: std::optional<info::machine>();
+}
+
+
+//-------------------------------------------------
+//  database::find_roms_by_crc
+//-------------------------------------------------
+
+info::rom_by_crc::view info::database::find_roms_by_crc(std::uint32_t crc32) const noexcept
+{
+	std::span<const binaries::rom_by_crc> span = getDataSpan<binaries::rom_by_crc>(m_state.m_roms_by_crc_position.offset(), m_state.m_roms_by_crc_position.count());
+	auto [first, last] = std::ranges::equal_range(span, crc32, { }, [](const binaries::rom_by_crc &x) { return x.m_crc32; });
+	return roms_by_crc().subview(first - span.begin(), last - first);
+}
+
+
+//-------------------------------------------------
+//  database::find_disks_by_sha1
+//-------------------------------------------------
+
+info::disk_by_sha1::view info::database::find_disks_by_sha1(const std::array<std::uint8_t, 20> &sha1) const noexcept
+{
+	std::span<const binaries::disk_by_sha1> span = getDataSpan<binaries::disk_by_sha1>(m_state.m_disks_by_sha1_position.offset(), m_state.m_disks_by_sha1_position.count());
+	auto [first, last] = std::ranges::equal_range(span, sha1, { }, [](const binaries::disk_by_sha1 &x) { return std::to_array(x.m_sha1); });
+	return disks_by_sha1().subview(first - span.begin(), last - first);
+}
+
+
+//-------------------------------------------------
+//  database::StringCache::find
+//-------------------------------------------------
+
+const QString *info::database::StringCache::find(std::uint32_t offset) const noexcept
+{
+	const Shard &shard = getShard(offset);
+	std::shared_lock lock(shard.m_mutex);
+
+	auto iter = shard.m_map.find(offset);
+	return iter != shard.m_map.end()
+		? &iter->second
+		: nullptr;
+}
+
+
+//-------------------------------------------------
+//  database::StringCache::emplace
+//-------------------------------------------------
+
+const QString &info::database::StringCache::emplace(std::uint32_t offset, QString &&string) noexcept
+{
+	Shard &shard = getShard(offset);
+	std::unique_lock lock(shard.m_mutex);
+
+	// std::unordered_map nodes are stable, so this reference will survive future insertions
+	auto iter = shard.m_map.try_emplace(offset, std::move(string)).first;
+	return iter->second;
+}
+
+
+//-------------------------------------------------
+//  database::StringCache::clear
+//-------------------------------------------------
+
+void info::database::StringCache::clear() noexcept
+{
+	for (Shard &shard : m_shards)
+	{
+		std::unique_lock lock(shard.m_mutex);
+		shard.m_map.clear();
+	}
+}
+
+
+//-------------------------------------------------
+//  database::StringCache::getShard
+//-------------------------------------------------
+
+info::database::StringCache::Shard &info::database::StringCache::getShard(std::uint32_t offset) noexcept
+{
+	// Fibonacci hashing; offsets are clustered so we want to scatter them
+	static_assert(std::tuple_size_v<decltype(m_shards)> == 16);
+	std::uint32_t hash = offset * 2654435769u;
+	return m_shards[hash >> 28];
+}
+
+
+//-------------------------------------------------
+//  database::StringCache::getShard
+//-------------------------------------------------
+
+const info::database::StringCache::Shard &info::database::StringCache::getShard(std::uint32_t offset) const noexcept
+{
+	return const_cast<StringCache *>(this)->getShard(offset);
+}
+
+
+//-------------------------------------------------
+//  info::database::ColdTable ctor
+//-------------------------------------------------
+
+info::database::ColdTable::ColdTable(std::span<const binaries::compressed_block> blocks, std::span<const std::uint8_t> compressedData, std::size_t blockSize, std::size_t size)
+	: m_blocks(blocks)
+	, m_compressedData(compressedData)
+	, m_blockSize(blockSize)
+	, m_size(size)
+	, m_blockLoaded(std::make_unique<std::atomic<bool>[]>(blocks.size()))
+{
+}
+
+
+//-------------------------------------------------
+//  info::database::ColdTable::blockSize - the
+//	uncompressed size of a block; always a whole
+//	number of records
+//-------------------------------------------------
+
+std::size_t info::database::ColdTable::blockSize(std::size_t recordSize) noexcept
+{
+	return std::max(binaries::COMPRESSED_BLOCK_SIZE / recordSize, (std::size_t)1) * recordSize;
+}
+
+
+//-------------------------------------------------
+//  info::database::ColdTable::create - validates
+//	the block directory for a table and consumes
+//	those blocks
+//-------------------------------------------------
+
+std::unique_ptr<info::database::ColdTable> info::database::ColdTable::create(std::span<const binaries::compressed_block> &blocks, std::span<const std::uint8_t> compressedData, std::size_t recordSize, std::size_t recordCount) noexcept
+{
+	std::size_t size = recordSize * recordCount;
+	std::size_t tableBlockSize = blockSize(recordSize);
+	std::size_t blockCount = (size + tableBlockSize - 1) / tableBlockSize;
+	if (blocks.size() < blockCount)
+		return { };
+
+	// every block needs to be within the compressed data, and no bigger than it would be raw
+	std::span<const binaries::compressed_block> tableBlocks = blocks.first(blockCount);
+	for (std::size_t i = 0; i < tableBlocks.size(); i++)
+	{
+		const binaries::compressed_block &block = tableBlocks[i];
+		std::size_t rawSize = std::min(tableBlockSize, size - i * tableBlockSize);
+		if ((std::size_t)block.m_offset + block.m_size > compressedData.size() || block.m_size > rawSize)
+			return { };
+	}
+
+	blocks = blocks.subspan(blockCount);
+	return std::make_unique<ColdTable>(tableBlocks, compressedData, tableBlockSize, size);
+}
+
+
+//-------------------------------------------------
+//  info::database::ColdTable::data
+//-------------------------------------------------
+
+std::span<const std::uint8_t> info::database::ColdTable::data() const noexcept
+{
+	// records are handed out as pointers into this buffer, so it needs to be
+	// allocated (but not populated) before any of them are
+	std::call_once(m_dataAllocated, [this]
+	{
+		m_data = std::make_unique_for_overwrite<std::uint8_t[]>(m_size);
+	});
+	return std::span<const std::uint8_t>(m_data.get(), m_size);
+}
+
+
+//-------------------------------------------------
+//  info::database::ColdTable::ensureLoaded
+//-------------------------------------------------
+
+void info::database::ColdTable::ensureLoaded(const void *ptr) const noexcept
+{
+	std::size_t offset = (const std::uint8_t *)ptr - m_data.get();
+	assert(offset < m_size);
+	std::size_t blockIndex = offset / m_blockSize;
+
+	if (!m_blockLoaded[blockIndex].load(std::memory_order_acquire))
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if (!m_blockLoaded[blockIndex].load(std::memory_order_relaxed))
+		{
+			loadBlock(blockIndex);
+			m_blockLoaded[blockIndex].store(true, std::memory_order_release);
+		}
+	}
+}
+
+
+//-------------------------------------------------
+//  info::database::ColdTable::loadBlock
+//-------------------------------------------------
+
+void info::database::ColdTable::loadBlock(std::size_t blockIndex) const noexcept
+{
+	const binaries::compressed_block &block = m_blocks[blockIndex];
+	std::uint8_t *dest = m_data.get() + blockIndex * m_blockSize;
+	std::size_t destSize = std::min(m_blockSize, m_size - blockIndex * m_blockSize);
+	const std::uint8_t *src = m_compressedData.data() + block.m_offset;
+
+	bool success;
+	if (block.m_size == destSize)
+	{
+		// stored raw
+		memcpy(dest, src, destSize);
+		success = true;
+	}
+	else
+	{
+		uLongf destLength = util::safe_static_cast<uLongf>(destSize);
+		success = uncompress(dest, &destLength, src, block.m_size) == Z_OK
+			&& destLength == destSize;
+	}
+
+	// if the block is corrupt, zeroing it is the best we can do (zero counts keep
+	// everything hanging off these records empty)
+	if (!success)
+		memset(dest, 0, destSize);
 }
 
 
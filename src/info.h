@@ -15,8 +15,15 @@
 #include "bindata.h"
 #include "utility.h"
 
+// Qt headers
+#include <QFile>
+
 // standard headers
 #include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
 #include <vector>
 #include <unordered_map>
 #include <iterator>
@@ -33,6 +40,7 @@ namespace info
 		const std::uint64_t MAGIC_HDR = 0x4D414D45494E464F;		// MAMEINFO
 		const std::uint16_t MAGIC_STRINGTABLE_BEGIN = 0x9D9B;
 		const std::uint16_t MAGIC_STRINGTABLE_END = 0x9F99;
+		const std::uint32_t COMPRESSED_BLOCK_SIZE = 0x10000;	// uncompressed size of a cold table block
 
 		struct header
 		{
@@ -55,6 +63,18 @@ namespace info
 			std::uint32_t	m_configuration_conditions_count;
 			std::uint32_t	m_software_lists_count;
 			std::uint32_t	m_ram_options_count;
+			std::uint32_t	m_machine_name_buckets_count;
+			std::uint32_t	m_manufacturer_groups_count;
+			std::uint32_t	m_year_groups_count;
+			std::uint32_t	m_sourcefile_groups_count;
+			std::uint32_t	m_cpu_groups_count;
+			std::uint32_t	m_sound_groups_count;
+			std::uint32_t	m_bios_groups_count;
+			std::uint32_t	m_machine_references_count;
+			std::uint32_t	m_roms_by_crc_count;
+			std::uint32_t	m_disks_by_sha1_count;
+			std::uint32_t	m_compressed_blocks_count;
+			std::uint32_t	m_compressed_data_size;
 		};
 
 		struct machine
@@ -90,6 +110,12 @@ namespace info
 			std::uint32_t	m_devices_count;
 			std::uint32_t	m_slots_index;
 			std::uint32_t	m_slots_count;
+			std::uint32_t	m_clones_index;
+			std::uint32_t	m_clones_count;
+			std::uint32_t	m_dependents_index;
+			std::uint32_t	m_dependents_count;
+			std::uint64_t	m_roms_size;
+			std::uint64_t	m_own_roms_size;
 			std::uint8_t	m_runnable;
 			std::uint8_t	m_is_bios;
 			std::uint8_t	m_is_device;
@@ -219,6 +245,7 @@ namespace info
 		{
 			std::uint32_t	m_name_strindex;
 			std::uint32_t	m_devname_strindex;
+			std::uint32_t	m_devname_machindex;
 			std::uint8_t	m_is_default;
 		};
 
@@ -236,10 +263,47 @@ namespace info
 			std::uint8_t	m_is_default;
 		};
 
+		struct machine_group
+		{
+			std::uint32_t	m_name_strindex;
+			std::uint32_t	m_machine_references_index;
+			std::uint32_t	m_machine_references_count;
+		};
+
+		struct machine_reference
+		{
+			std::uint32_t	m_machindex;
+		};
+
+		// sorted by CRC32
+		struct rom_by_crc
+		{
+			std::uint32_t	m_crc32;
+			std::uint32_t	m_rom_index;
+			std::uint32_t	m_machindex;
+		};
+
+		// sorted by SHA-1
+		struct disk_by_sha1
+		{
+			std::uint8_t	m_sha1[20];
+			std::uint32_t	m_disk_index;
+			std::uint32_t	m_machindex;
+		};
+
+		// cold tables (chips, displays and configurations) are stored as a series of
+		// independently compressed blocks; a block whose size matches its uncompressed
+		// size is stored raw
+		struct compressed_block
+		{
+			std::uint32_t	m_offset;
+			std::uint32_t	m_size;
+		};
+
 		class salt
 		{
 		public:
-			salt() : m_magic1(3133731337), m_magic2(0xF00D), m_version(1) { }
+			salt() : m_magic1(3133731337), m_magic2(0xF00D), m_version(4) { }
 
 			bool operator==(const salt &that) const
 			{
@@ -268,6 +332,8 @@ namespace info
 	class database_builder;
 	class machine;
 
+	typedef bindata::view<database, machine, binaries::machine_reference> machine_list;
+
 	// ======================> biosset
 	class biosset : public bindata::entry<database, biosset, binaries::biosset>
 	{
@@ -622,9 +688,13 @@ namespace info
 		{
 		}
 
+		machine(const database &db, const binaries::machine_reference &reference);
+
 		// methods
 		std::optional<info::device> find_device(const QString &tag) const noexcept;
+		std::optional<info::device> find_device(std::u8string_view tag) const noexcept;
 		std::optional<info::chip> find_chip(const QString &chipName) const noexcept;
+		std::optional<info::chip> find_chip(std::u8string_view chipName) const noexcept;
 		std::optional<info::machine> clone_of() const noexcept;
 		std::optional<info::machine> rom_of() const noexcept;
 
@@ -644,6 +714,9 @@ namespace info
 		const QString &description() const					{ return get_string(inner().m_description_strindex); }
 		const QString &year() const							{ return get_string(inner().m_year_strindex); }
 		const QString &manufacturer() const					{ return get_string(inner().m_manufacturer_strindex); }
+		std::uint64_t roms_size() const						{ return inner().m_roms_size; }
+		std::uint64_t own_roms_size() const					{ return inner().m_own_roms_size; }
+		std::uint32_t index() const;
 
 		// operators
 		bool operator==(const info::machine &that) const
@@ -663,6 +736,8 @@ namespace info
 		configuration::view			configurations() const;
 		software_list::view			software_lists() const;
 		ram_option::view			ram_options() const;
+		machine_list				clones() const;
+		machine_list				dependents() const;
 
 	private:
 		static std::optional<bool> decode_optional_bool(std::uint8_t b)
@@ -674,6 +749,59 @@ namespace info
 	};
 
 
+	// ======================> machine_group - a set of (runnable) machines sharing
+	// a particular manufacturer, year, chip etc
+	class machine_group : public bindata::entry<database, machine_group, binaries::machine_group>
+	{
+	public:
+		machine_group(const database &db, const binaries::machine_group &inner)
+			: entry(db, inner)
+		{
+		}
+
+		// methods
+		bool contains(const info::machine &machine) const noexcept;
+
+		// properties
+		const QString &name() const { return get_string(inner().m_name_strindex); }
+
+		// views
+		machine_list machines() const;
+	};
+
+
+	// ======================> rom_by_crc - a ROM (and the machine that has it) found by CRC32
+	class rom_by_crc : public bindata::entry<database, rom_by_crc, binaries::rom_by_crc>
+	{
+	public:
+		rom_by_crc(const database &db, const binaries::rom_by_crc &inner)
+			: entry(db, inner)
+		{
+		}
+
+		// properties
+		std::uint32_t crc32() const { return inner().m_crc32; }
+		info::rom rom() const;
+		info::machine machine() const;
+	};
+
+
+	// ======================> disk_by_sha1 - a disk (and the machine that has it) found by SHA-1
+	class disk_by_sha1 : public bindata::entry<database, disk_by_sha1, binaries::disk_by_sha1>
+	{
+	public:
+		disk_by_sha1(const database &db, const binaries::disk_by_sha1 &inner)
+			: entry(db, inner)
+		{
+		}
+
+		// properties
+		std::array<uint8_t, 20> sha1() const { return std::to_array(inner().m_sha1); }
+		info::disk disk() const;
+		info::machine machine() const;
+	};
+
+
 	// ======================> database
 	class database
 	{
@@ -693,6 +821,8 @@ namespace info
 		void reset() noexcept;
 		std::optional<machine> find_machine(const QString &machine_name) const noexcept;
 		std::optional<machine> find_machine(std::u8string_view machine_name) const noexcept;
+		rom_by_crc::view find_roms_by_crc(std::uint32_t crc32) const noexcept;
+		disk_by_sha1::view find_disks_by_sha1(const std::array<std::uint8_t, 20> &sha1) const noexcept;
 		const QString &version() const noexcept { return *m_version; }
 		void addOnChangedHandler(std::function<void()> &&onChanged) noexcept;
 
@@ -712,19 +842,102 @@ namespace info
 		auto configuration_conditions() const	{ return configuration_condition::view(*this, m_state.m_configuration_conditions_position); }
 		auto software_lists() const				{ return software_list::view(*this, m_state.m_software_lists_position); }
 		auto ram_options() const				{ return ram_option::view(*this, m_state.m_ram_options_position); }
+		auto manufacturer_groups() const		{ return machine_group::view(*this, m_state.m_manufacturer_groups_position); }
+		auto year_groups() const				{ return machine_group::view(*this, m_state.m_year_groups_position); }
+		auto sourcefile_groups() const			{ return machine_group::view(*this, m_state.m_sourcefile_groups_position); }
+		auto cpu_groups() const					{ return machine_group::view(*this, m_state.m_cpu_groups_position); }
+		auto sound_groups() const				{ return machine_group::view(*this, m_state.m_sound_groups_position); }
+		auto bios_groups() const				{ return machine_group::view(*this, m_state.m_bios_groups_position); }
+		auto machine_references() const			{ return machine_list(*this, m_state.m_machine_references_position); }
+		auto roms_by_crc() const				{ return rom_by_crc::view(*this, m_state.m_roms_by_crc_position); }
+		auto disks_by_sha1() const				{ return disk_by_sha1::view(*this, m_state.m_disks_by_sha1_position); }
 
 		// statics
 		static uint64_t calculate_sizes_hash() noexcept;
+		static std::optional<binaries::header> read_header(QIODevice &input) noexcept;
 
 		// should only be called by info classes
 		const QString &get_string(std::uint32_t offset) const noexcept;
+		std::uint32_t get_machine_index(const binaries::machine &machine) const noexcept;
+		std::optional<std::uint32_t> find_device_index(std::uint32_t devices_index, std::uint32_t devices_count, std::u8string_view tag) const noexcept;
+		std::optional<std::uint32_t> find_chip_index(std::uint32_t chips_index, std::uint32_t chips_count, std::u8string_view chip_name) const noexcept;
+
+		// should only be called by info classes; decompresses the block holding a
+		// record from a cold table (a no-op for everything else)
+		template<typename T>
+		void ensureLoaded(const T &item) const noexcept
+		{
+			if constexpr (coldTableIndex<T>() >= 0)
+				m_state.m_coldTables[coldTableIndex<T>()]->ensureLoaded(&item);
+		}
 
 	private:
+		// ======================> StringCache
+		// thread safe cache of decoded strings; references handed out remain stable
+		// until the cache is cleared (which only happens when the database changes)
+		class StringCache
+		{
+		public:
+			const QString *find(std::uint32_t offset) const noexcept;
+			const QString &emplace(std::uint32_t offset, QString &&string) noexcept;
+			void clear() noexcept;
+
+		private:
+			struct Shard
+			{
+				mutable std::shared_mutex						m_mutex;
+				std::unordered_map<std::uint32_t, QString>		m_map;
+			};
+
+			std::array<Shard, 16>								m_shards;
+
+			Shard &getShard(std::uint32_t offset) noexcept;
+			const Shard &getShard(std::uint32_t offset) const noexcept;
+		};
+
+		// ======================> ColdTable
+		// a table stored as compressed blocks that are decompressed on first access; the
+		// buffer they are decompressed into is not allocated until the table is first used
+		class ColdTable
+		{
+		public:
+			ColdTable(std::span<const binaries::compressed_block> blocks, std::span<const std::uint8_t> compressedData, std::size_t blockSize, std::size_t size);
+
+			static std::size_t blockSize(std::size_t recordSize) noexcept;
+			static std::unique_ptr<ColdTable> create(std::span<const binaries::compressed_block> &blocks, std::span<const std::uint8_t> compressedData, std::size_t recordSize, std::size_t recordCount) noexcept;
+			std::span<const std::uint8_t> data() const noexcept;
+			void ensureLoaded(const void *ptr) const noexcept;
+
+		private:
+			std::span<const binaries::compressed_block>		m_blocks;
+			std::span<const std::uint8_t>					m_compressedData;
+			std::size_t										m_blockSize;
+			std::size_t										m_size;
+			mutable std::unique_ptr<std::uint8_t[]>			m_data;
+			mutable std::once_flag							m_dataAllocated;
+			std::unique_ptr<std::atomic<bool>[]>			m_blockLoaded;
+			mutable std::mutex								m_mutex;
+
+			void loadBlock(std::size_t blockIndex) const noexcept;
+		};
+
+		static constexpr std::size_t COLD_TABLE_COUNT = 5;
+
+		// outcome of trying to memory map an info DB
+		enum class load_mapped_result
+		{
+			SUCCESS,
+			COULD_NOT_MAP,		// the file could not be opened or mapped; reading it might still work
+			INVALID				// the file is not a usable info DB (e.g. - another format or MAME version)
+		};
+
 		struct State
 		{
 			State();
 
-			std::vector<std::uint8_t>						m_data;
+			std::vector<std::uint8_t>						m_ownedData;	// populated when loaded from a QIODevice
+			std::unique_ptr<QFile>							m_mappedFile;	// populated when memory mapped
+			std::span<const std::uint8_t>					m_data;			// points into one of the above
 			bindata::view_position							m_machines_position;
 			bindata::view_position							m_biossets_position;
 			bindata::view_position							m_roms_position;
@@ -741,12 +954,26 @@ namespace info
 			bindata::view_position							m_configuration_conditions_position;
 			bindata::view_position							m_software_lists_position;
 			bindata::view_position							m_ram_options_position;
+			bindata::view_position							m_machine_name_buckets_position;
+			bindata::view_position							m_machine_name_slots_position;
+			bindata::view_position							m_manufacturer_groups_position;
+			bindata::view_position							m_year_groups_position;
+			bindata::view_position							m_sourcefile_groups_position;
+			bindata::view_position							m_cpu_groups_position;
+			bindata::view_position							m_sound_groups_position;
+			bindata::view_position							m_bios_groups_position;
+			bindata::view_position							m_machine_references_position;
+			bindata::view_position							m_roms_by_crc_position;
+			bindata::view_position							m_disks_by_sha1_position;
+			bindata::view_position							m_devices_by_tag_position;
+			bindata::view_position							m_chips_by_name_position;
 			std::uint32_t									m_string_table_offset;
+			std::array<std::unique_ptr<ColdTable>, COLD_TABLE_COUNT>	m_coldTables;
 		};
 
 		// member variables
 		State												m_state;
-		mutable std::unordered_map<std::uint32_t, QString>	m_loaded_strings;
+		mutable StringCache									m_loaded_strings;
 		const QString *										m_version;
 		std::vector<std::function<void()>>					m_onChangedHandlers;
 
@@ -771,16 +998,59 @@ namespace info
 		template<typename T>
 		static std::optional<std::span<const T>> tryGetDataSpan(const State &state, size_t offset, std::optional<size_t> count = { }) noexcept
 		{
-			size_t actualCount = count.value_or(state.m_data.size() - offset);
-			if (offset > state.m_data.size() || (offset + actualCount * sizeof(T) > state.m_data.size()))
+			std::span<const std::uint8_t> data = getTableData<T>(state);
+			size_t actualCount = count.value_or(data.size() - offset);
+			if (offset > data.size() || (offset + actualCount * sizeof(T) > data.size()))
 				return { };
-			const T *ptr = reinterpret_cast<const T *>(&state.m_data.data()[offset]);
+			const T *ptr = reinterpret_cast<const T *>(&data.data()[offset]);
 			return std::span(ptr, ptr + actualCount);
 		}
 
+		// cold tables live in their own buffers
+		template<typename T>
+		static std::span<const std::uint8_t> getTableData(const State &state) noexcept
+		{
+			if constexpr (coldTableIndex<T>() >= 0)
+			{
+				const ColdTable *coldTable = state.m_coldTables[coldTableIndex<T>()].get();
+				return coldTable ? coldTable->data() : std::span<const std::uint8_t>();
+			}
+			else
+			{
+				return state.m_data;
+			}
+		}
+
+		// which tables are cold (and hence compressed)?
+		template<typename T>
+		static constexpr int coldTableIndex() noexcept
+		{
+			if constexpr (std::is_same_v<T, binaries::chip>)
+				return 0;
+			else if constexpr (std::is_same_v<T, binaries::display>)
+				return 1;
+			else if constexpr (std::is_same_v<T, binaries::configuration>)
+				return 2;
+			else if constexpr (std::is_same_v<T, binaries::configuration_setting>)
+				return 3;
+			else if constexpr (std::is_same_v<T, binaries::configuration_condition>)
+				return 4;
+			else
+				return -1;
+		}
+
 		// private functions
+		static std::optional<binaries::header> unsalt_header(const binaries::header &salted_hdr) noexcept;
+		bool loadState(State &&newState, const binaries::header &salted_hdr, const QString &expected_version) noexcept;
+		load_mapped_result loadMapped(const QString &file_name, const QString &expected_version) noexcept;
+		template<typename T> static bool loadColdTable(State &state, std::span<const binaries::compressed_block> &blocks, std::span<const std::uint8_t> compressedData, std::uint32_t count) noexcept;
 		void onChanged() noexcept;
-		std::optional<int> find_machine_index(const QString &machine_name) const noexcept;
+		std::optional<std::uint32_t> find_machine_index(std::u8string_view machine_name) const noexcept;
+		bool string_equals(std::uint32_t strindex, std::u8string_view s) const noexcept;
+		std::strong_ordering string_compare(std::uint32_t strindex, std::u8string_view s) const noexcept;
+		template<typename T, typename TFunc> std::optional<std::uint32_t> find_sorted(const bindata::view_position &items_position, const bindata::view_position &sorted_position,
+			std::uint32_t index, std::uint32_t count, std::u8string_view s, TFunc strindexFunc) const noexcept;
+		static std::uint32_t machine_name_hash(std::u8string_view s, std::uint32_t seed) noexcept;
 		static std::optional<std::uint32_t> tryEncodeSmallStringChar(std::u8string_view s, std::size_t i) noexcept;
 		static std::optional<std::uint32_t> tryEncodeAsSmallString(std::u8string_view s) noexcept;
 		static std::optional<std::array<char8_t, 6>> tryDecodeAsSmallString(std::uint32_t value) noexcept;
@@ -799,6 +1069,24 @@ namespace info
 	inline configuration_setting::view	configuration::settings() const	{ return db().configuration_settings().subview(inner().m_configuration_settings_index, inner().m_configuration_settings_count); }
 	inline software_list::view			machine::software_lists() const	{ return db().software_lists().subview(inner().m_software_lists_index, inner().m_software_lists_count); }
 	inline ram_option::view				machine::ram_options() const	{ return db().ram_options().subview(inner().m_ram_options_index, inner().m_ram_options_count); }
+	inline machine_list					machine::clones() const			{ return db().machine_references().subview(inner().m_clones_index, inner().m_clones_count); }
+	inline machine_list					machine::dependents() const		{ return db().machine_references().subview(inner().m_dependents_index, inner().m_dependents_count); }
+	inline machine_list					machine_group::machines() const	{ return db().machine_references().subview(inner().m_machine_references_index, inner().m_machine_references_count); }
+
+	inline rom							rom_by_crc::rom() const			{ return db().roms()[inner().m_rom_index]; }
+	inline machine						rom_by_crc::machine() const		{ return db().machines()[inner().m_machindex]; }
+	inline disk							disk_by_sha1::disk() const		{ return db().disks()[inner().m_disk_index]; }
+	inline machine						disk_by_sha1::machine() const	{ return db().machines()[inner().m_machindex]; }
+
+	inline machine::machine(const database &db, const binaries::machine_reference &reference)
+		: machine(db.machines()[reference.m_machindex])
+	{
+	}
+
+	inline std::uint32_t machine::index() const
+	{
+		return db().get_machine_index(inner());
+	}
 }
 
 
@@ -12,9 +12,18 @@
 #include "throttler.h"
 
 // standard headers
+#include <bit>
 #include <chrono>
 #include <cmath>
+#include <future>
+#include <map>
+#include <numeric>
 #include <ranges>
+#include <unordered_set>
+#include <utility>
+
+// dependency headers
+#include <zlib.h>
 
 
 //**************************************************************************
@@ -220,11 +229,113 @@ static void binaryWipe(T &x)
 }
 
 
+//-------------------------------------------------
+//  appendRange - appends a range of records from
+//	another builder's table, returning the new index
+//-------------------------------------------------
+
+template<class T, class TFunc>
+static std::uint32_t appendRange(std::vector<T> &dest, const std::vector<T> &source, std::uint32_t index, std::uint32_t count, TFunc func)
+{
+	std::uint32_t result = to_uint32(dest.size());
+	for (std::uint32_t i = index; i < index + count; i++)
+	{
+		T &item = dest.emplace_back(source[i]);
+		func(item);
+	}
+	return result;
+}
+
+
+//-------------------------------------------------
+//  emplaceRecord - appends a record to one of the
+//	tables, letting the profiler know when the
+//	table had to be reallocated (which means that
+//	the capacity plan fell short)
+//-------------------------------------------------
+
+template<class T>
+static T &emplaceRecord(std::vector<T> &table, const char *tableName, std::uint32_t &reallocationCount)
+{
+	if (table.size() < table.capacity())
+		return table.emplace_back();
+
+	reallocationCount++;
+	std::string label = std::string("database_builder reallocating ") + tableName;
+	ProfilerScope prof(label.c_str());
+	return table.emplace_back();
+}
+
+
+//-------------------------------------------------
+//  ctor
+//-------------------------------------------------
+
+info::database_builder::database_builder(int shardCount)
+	: m_shardCount(std::max(shardCount, 1))
+{
+}
+
+
+//-------------------------------------------------
+//  defaultCapacityPlan - what we know about MAME
+//	0.239, for when we have no previous info DB
+//-------------------------------------------------
+
+info::binaries::header info::database_builder::defaultCapacityPlan() noexcept
+{
+	info::binaries::header result = { };
+	result.m_machines_count					= 44092;
+	result.m_biossets_count					= 34067;
+	result.m_roms_count						= 329670;
+	result.m_disks_count					= 1193;
+	result.m_devices_count					= 10738;
+	result.m_features_count					= 20412;
+	result.m_chips_count					= 174679;
+	result.m_displays_count					= 20194;
+	result.m_samples_count					= 19402;
+	result.m_configurations_count			= 553822;
+	result.m_configuration_settings_count	= 1639291;
+	result.m_configuration_conditions_count	= 6853;
+	result.m_software_lists_count			= 6337;
+	result.m_ram_options_count				= 6383;
+	return result;
+}
+
+
+//-------------------------------------------------
+//  plan_capacity - sizes the tables based on the
+//	header of a previous info DB (see
+//	info::database::read_header())
+//-------------------------------------------------
+
+void info::database_builder::plan_capacity(const info::binaries::header &previous_header) noexcept
+{
+	m_capacity_plan = previous_header;
+}
+
+
 //-------------------------------------------------
 //  process_xml()
 //-------------------------------------------------
 
 bool info::database_builder::process_xml(QIODevice &input, QString &error_message, const ProcessXmlCallback &progressCallback) noexcept
+{
+	if (!parse_xml(input, error_message, progressCallback))
+		return false;
+
+	finalize();
+	return true;
+}
+
+
+//-------------------------------------------------
+//  parse_xml - parses -listxml output; this is
+//	the only part of building that can be split
+//	across shards (see merge())
+//-------------------------------------------------
+
+bool info::database_builder::parse_xml(QIODevice &input, QString &error_message, const ProcessXmlCallback &progressCallback) noexcept
 {
 	using namespace std::chrono_literals;
 
@@ -247,45 +358,47 @@ bool info::database_builder::process_xml(QIODevice &input, QString &error_messag
 		}
 	};
 
-	// prepare header and magic variables
-	info::binaries::header header = { 0, };
-	header.m_magic = info::binaries::MAGIC_HDR;
-	header.m_sizes_hash = info::database::calculate_sizes_hash();
-
-	// reserve space based on what we know about MAME 0.239
-	m_biossets.reserve(36000);					// 34067 bios sets
-	m_roms.reserve(350000);						// 329670 roms
-	m_disks.reserve(1400);						// 1193 disks
-	m_machines.reserve(48000);					// 44092 machines
-	m_devices.reserve(12000);					// 10738 devices
-	m_features.reserve(22000);					// 20412 features
-	m_chips.reserve(190000);					// 174679 chips
-	m_displays.reserve(22000);					// 20194 displays
-	m_samples.reserve(21000);					// 19402 samples
-	m_configurations.reserve(600000);			// 553822 configurations
-	m_configuration_conditions.reserve(7500);	// 6853 conditions
-	m_configuration_settings.reserve(1700000);	// 1639291 settings
-	m_software_lists.reserve(6800);				// 6337 software lists
-	m_ram_options.reserve(6800);				// 6383 ram options
+	// reserve space based on the capacity plan, with a little headroom because MAME only ever grows (when
+	// sharding, each shard gets its share)
+	auto reserve = [this](auto &table, std::uint32_t count)
+	{
+		table.reserve((count + count / 16) / m_shardCount);
+	};
+	reserve(m_machines,					m_capacity_plan.m_machines_count);
+	reserve(m_biossets,					m_capacity_plan.m_biossets_count);
+	reserve(m_roms,						m_capacity_plan.m_roms_count);
+	reserve(m_disks,					m_capacity_plan.m_disks_count);
+	reserve(m_devices,					m_capacity_plan.m_devices_count);
+	reserve(m_slots,					m_capacity_plan.m_slots_count);
+	reserve(m_slot_options,				m_capacity_plan.m_slot_options_count);
+	reserve(m_features,					m_capacity_plan.m_features_count);
+	reserve(m_chips,					m_capacity_plan.m_chips_count);
+	reserve(m_displays,					m_capacity_plan.m_displays_count);
+	reserve(m_samples,					m_capacity_plan.m_samples_count);
+	reserve(m_configurations,			m_capacity_plan.m_configurations_count);
+	reserve(m_configuration_conditions,	m_capacity_plan.m_configuration_conditions_count);
+	reserve(m_configuration_settings,	m_capacity_plan.m_configuration_settings_count);
+	reserve(m_software_lists,			m_capacity_plan.m_software_lists_count);
+	reserve(m_ram_options,				m_capacity_plan.m_ram_options_count);
 
 	// parse the -listxml output
 	XmlParser xml;
 	std::u8string current_device_extensions;
 	std::uint32_t empty_strindex = m_strings.get(u8"");
-	xml.onElementBegin({ "mame" }, [this, &header](const XmlParser::Attributes &attributes)
+	xml.onElementBegin({ "mame" }, [this](const XmlParser::Attributes &attributes)
 	{
 		ProfilerScope prof(CURRENT_FUNCTION);
-		const auto [build] = attributes.get("build");
-		header.m_build_strindex = m_strings.get(build);
+		const auto [build] = attributes.get<"build">();
+		m_build_strindex = m_strings.get(build);
 	});
 	xml.onElementBegin({ "mame", "machine" }, [this, empty_strindex](const XmlParser::Attributes &attributes)
 	{
 		ProfilerScope prof(CURRENT_FUNCTION);
 
-		const auto [runnable, name, sourcefile, cloneof, romof, isbios, isdevice, ismechanical] = attributes.get(
-			"runnable", "name", "sourcefile", "cloneof", "romof", "isbios", "isdevice", "ismechanical");
+		const auto [runnable, name, sourcefile, cloneof, romof, isbios, isdevice, ismechanical] = attributes.get<
+			"runnable", "name", "sourcefile", "cloneof", "romof", "isbios", "isdevice", "ismechanical">();
 
-		info::binaries::machine &machine = m_machines.emplace_back();
+		info::binaries::machine &machine = emplaceRecord(m_machines, "machines", m_reallocation_count);
 		binaryWipe(machine);
 		machine.m_runnable				= encodeBool(runnable.as<bool>().value_or(true));
 		machine.m_name_strindex			= m_strings.get(name);
@@ -319,6 +432,12 @@ bool info::database_builder::process_xml(QIODevice &input, QString &error_messag
 		machine.m_devices_count			= 0;
 		machine.m_slots_index			= to_uint32(m_slots.size());
 		machine.m_slots_count			= 0;
+		machine.m_clones_index			= 0;
+		machine.m_clones_count			= 0;
+		machine.m_dependents_index		= 0;
+		machine.m_dependents_count		= 0;
+		machine.m_roms_size				= 0;
+		machine.m_own_roms_size			= 0;
 		machine.m_description_strindex	= empty_strindex;
 		machine.m_year_strindex			= empty_strindex;
 		machine.m_manufacturer_strindex = empty_strindex;
@@ -330,18 +449,18 @@ bool info::database_builder::process_xml(QIODevice &input, QString &error_messag
 		machine.m_incomplete			= encodeBool(std::nullopt);
 		machine.m_sound_channels		= ~0;
 	});
-	xml.onElementEnd({ "mame", "machine", "description" }, [this, &reportProgressIfAppropriate](std::u8string &&content)
+	xml.onElementEnd({ "mame", "machine", "description" }, [this, &reportProgressIfAppropriate](std::u8string_view content)
 	{
 		ProfilerScope prof(CURRENT_FUNCTION);
 		util::last(m_machines).m_description_strindex = m_strings.get(content);
 		reportProgressIfAppropriate(util::last(m_machines));
 	});
-	xml.onElementEnd({ "mame", "machine", "year" }, [this](std::u8string &&content)
+	xml.onElementEnd({ "mame", "machine", "year" }, [this](std::u8string_view content)
 	{
 		ProfilerScope prof(CURRENT_FUNCTION);
 		util::last(m_machines).m_year_strindex = m_strings.get(content);
 	});
-	xml.onElementEnd({ "mame", "machine", "manufacturer" }, [this](std::u8string &&content)
+	xml.onElementEnd({ "mame", "machine", "manufacturer" }, [this](std::u8string_view content)
 	{
 		ProfilerScope prof(CURRENT_FUNCTION);
 		util::last(m_machines).m_manufacturer_strindex = m_strings.get(content);
@@ -349,9 +468,9 @@ bool info::database_builder::process_xml(QIODevice &input, QString &error_messag
 	xml.onElementBegin({ "mame", "machine", "biosset" }, [this](const XmlParser::Attributes &attributes)
 	{
 		ProfilerScope prof(CURRENT_FUNCTION);
-		const auto [name, description, is_default] = attributes.get("name", "description", "default");
+		const auto [name, description, is_default] = attributes.get<"name", "description", "default">();
 
-		info::binaries::biosset &biosset = m_biossets.emplace_back();
+		info::binaries::biosset &biosset = emplaceRecord(m_biossets, "biossets", m_reallocation_count);
 		binaryWipe(biosset);
 		biosset.m_name_strindex				= m_strings.get(name);
 		biosset.m_description_strindex		= m_strings.get(description);
@@ -361,10 +480,10 @@ bool info::database_builder::process_xml(QIODevice &input, QString &error_messag
 	xml.onElementBegin({ "mame", "machine", "rom" }, [this](const XmlParser::Attributes &attributes)
 	{
 		ProfilerScope prof(CURRENT_FUNCTION);
-		const auto [name, bios, size, crc, sha1, merge, region, offset, status, optional] = attributes.get(
-			"name", "bios", "size", "crc", "sha1", "merge", "region", "offset", "status", "optional");
+		const auto [name, bios, size, crc, sha1, merge, region, offset, status, optional] = attributes.get<
+			"name", "bios", "size", "crc", "sha1", "merge", "region", "offset", "status", "optional">();
 
-		info::binaries::rom &rom = m_roms.emplace_back();
+		info::binaries::rom &rom = emplaceRecord(m_roms, "roms", m_reallocation_count);
 		binaryWipe(rom);
 		rom.m_name_strindex					= m_strings.get(name);
 		rom.m_bios_strindex					= m_strings.get(bios);
@@ -376,15 +495,21 @@ bool info::database_builder::process_xml(QIODevice &input, QString &error_messag
 		rom.m_offset						= offset.as<std::uint64_t>(16).value_or(0);
 		rom.m_status						= encodeEnum(status.as<info::rom::dump_status_t>(s_dump_status_parser));
 		rom.m_optional						= encodeBool(optional.as<bool>().value_or(false));
-		util::last(m_machines).m_roms_count++;
+
+		// tally up the size; ROMs that are merged come from the parent or BIOS
+		info::binaries::machine &machine = util::last(m_machines);
+		machine.m_roms_count++;
+		machine.m_roms_size += rom.m_size;
+		if (!merge)
+			machine.m_own_roms_size += rom.m_size;
 	});
 	xml.onElementBegin({ "mame", "machine", "disk" }, [this](const XmlParser::Attributes &attributes)
 	{
 		ProfilerScope prof(CURRENT_FUNCTION);
-		const auto [name, sha1, merge, region, index, writable, status, optional] = attributes.get(
-			"name", "sha1", "merge", "region", "index", "writable", "status", "optional");
+		const auto [name, sha1, merge, region, index, writable, status, optional] = attributes.get<
+			"name", "sha1", "merge", "region", "index", "writable", "status", "optional">();
 
-		info::binaries::disk &disk = m_disks.emplace_back();
+		info::binaries::disk &disk = emplaceRecord(m_disks, "disks", m_reallocation_count);
 		binaryWipe(disk);
 		disk.m_name_strindex				= m_strings.get(name);
 		binaryFromHex(disk.m_sha1,			  sha1);
@@ -399,9 +524,9 @@ bool info::database_builder::process_xml(QIODevice &input, QString &error_messag
 	xml.onElementBegin({ "mame", "machine", "feature" }, [this](const XmlParser::Attributes &attributes)
 	{
 		ProfilerScope prof(CURRENT_FUNCTION);
-		const auto [type, status, overall] = attributes.get("type", "status", "overall");
+		const auto [type, status, overall] = attributes.get<"type", "status", "overall">();
 
-		info::binaries::feature &feature = m_features.emplace_back();
+		info::binaries::feature &feature = emplaceRecord(m_features, "features", m_reallocation_count);
 		binaryWipe(feature);
 		feature.m_type		= encodeEnum(type.as<info::feature::type_t>			(s_feature_type_parser));
 		feature.m_status	= encodeEnum(status.as<info::feature::quality_t>	(s_feature_quality_parser));
@@ -411,9 +536,9 @@ bool info::database_builder::process_xml(QIODevice &input, QString &error_messag
 	xml.onElementBegin({ "mame", "machine", "chip" }, [this](const XmlParser::Attributes &attributes)
 	{
 		ProfilerScope prof(CURRENT_FUNCTION);
-		const auto [type, name, tag, clock] = attributes.get("type", "name", "tag", "clock");
+		const auto [type, name, tag, clock] = attributes.get<"type", "name", "tag", "clock">();
 
-		info::binaries::chip &chip = m_chips.emplace_back();
+		info::binaries::chip &chip = emplaceRecord(m_chips, "chips", m_reallocation_count);
 		binaryWipe(chip);
 		chip.m_type				= encodeEnum(type.as<info::chip::type_t>(s_chip_type_parser));
 		chip.m_name_strindex	= m_strings.get(name);
@@ -425,10 +550,10 @@ bool info::database_builder::process_xml(QIODevice &input, QString &error_messag
 	xml.onElementBegin({ "mame", "machine", "display" }, [this](const XmlParser::Attributes &attributes)
 	{
 		ProfilerScope prof(CURRENT_FUNCTION);
-		const auto [tag, width, height, refresh, pixclock, htotal, hbend, hbstart, vtotal, vbend, vbstart, type, rotate, flipx] = attributes.get(
-			"tag", "width", "height", "refresh", "pixclock", "htotal", "hbend", "hbstart", "vtotal", "vbend", "vbstart", "type", "rotate", "flipx");
+		const auto [tag, width, height, refresh, pixclock, htotal, hbend, hbstart, vtotal, vbend, vbstart, type, rotate, flipx] = attributes.get<
+			"tag", "width", "height", "refresh", "pixclock", "htotal", "hbend", "hbstart", "vtotal", "vbend", "vbstart", "type", "rotate", "flipx">();
 
-		info::binaries::display &display = m_displays.emplace_back();
+		info::binaries::display &display = emplaceRecord(m_displays, "displays", m_reallocation_count);
 		binaryWipe(display);
 		display.m_tag_strindex	= m_strings.get(tag);
 		display.m_width			= width.as<std::uint32_t>().value_or(~0);
@@ -449,9 +574,9 @@ bool info::database_builder::process_xml(QIODevice &input, QString &error_messag
 	xml.onElementBegin({ "mame", "machine", "sample" }, [this](const XmlParser::Attributes &attributes)
 	{
 		ProfilerScope prof(CURRENT_FUNCTION);
-		const auto [name] = attributes.get("name");
+		const auto [name] = attributes.get<"name">();
 
-		info::binaries::sample &sample = m_samples.emplace_back();
+		info::binaries::sample &sample = emplaceRecord(m_samples, "samples", m_reallocation_count);
 		binaryWipe(sample);
 		sample.m_name_strindex	= m_strings.get(name);
 		util::last(m_machines).m_samples_count++;
@@ -460,9 +585,9 @@ bool info::database_builder::process_xml(QIODevice &input, QString &error_messag
 						 { "mame", "machine", "dipswitch" } }, [this](const XmlParser::Attributes &attributes)
 	{
 		ProfilerScope prof(CURRENT_FUNCTION);
-		const auto [name, tag, mask] = attributes.get("name", "tag", "mask");
+		const auto [name, tag, mask] = attributes.get<"name", "tag", "mask">();
 
-		info::binaries::configuration &configuration = m_configurations.emplace_back();
+		info::binaries::configuration &configuration = emplaceRecord(m_configurations, "configurations", m_reallocation_count);
 		binaryWipe(configuration);
 		configuration.m_name_strindex					= m_strings.get(name);
 		configuration.m_tag_strindex					= m_strings.get(tag);
@@ -476,9 +601,9 @@ bool info::database_builder::process_xml(QIODevice &input, QString &error_messag
 						 { "mame", "machine", "dipswitch", "dipvalue" } }, [this](const XmlParser::Attributes &attributes)
 	{
 		ProfilerScope prof(CURRENT_FUNCTION);
-		const auto [name, value] = attributes.get("name", "value");
+		const auto [name, value] = attributes.get<"name", "value">();
 
-		info::binaries::configuration_setting &configuration_setting = m_configuration_settings.emplace_back();
+		info::binaries::configuration_setting &configuration_setting = emplaceRecord(m_configuration_settings, "configuration_settings", m_reallocation_count);
 		binaryWipe(configuration_setting);
 		configuration_setting.m_name_strindex		= m_strings.get(name);
 		configuration_setting.m_conditions_index	= to_uint32(m_configuration_conditions.size());
@@ -490,9 +615,9 @@ bool info::database_builder::process_xml(QIODevice &input, QString &error_messag
 						 { "mame", "machine", "dipswitch", "dipvalue", "condition" } }, [this](const XmlParser::Attributes &attributes)
 	{
 		ProfilerScope prof(CURRENT_FUNCTION);
-		const auto [tag, relation, mask, value] = attributes.get("tag", "relation", "mask", "value");
+		const auto [tag, relation, mask, value] = attributes.get<"tag", "relation", "mask", "value">();
 
-		info::binaries::configuration_condition &configuration_condition = m_configuration_conditions.emplace_back();
+		info::binaries::configuration_condition &configuration_condition = emplaceRecord(m_configuration_conditions, "configuration_conditions", m_reallocation_count);
 		binaryWipe(configuration_condition);
 		configuration_condition.m_tag_strindex			= m_strings.get(tag);
 		configuration_condition.m_relation				= encodeEnum(relation.as<info::configuration_condition::relation_t>(s_relation_parser));
@@ -502,9 +627,9 @@ bool info::database_builder::process_xml(QIODevice &input, QString &error_messag
 	xml.onElementBegin({ "mame", "machine", "device" }, [this, &current_device_extensions, empty_strindex](const XmlParser::Attributes &attributes)
 	{
 		ProfilerScope prof(CURRENT_FUNCTION);
-		const auto [type, tag, interface, mandatory] = attributes.get("type", "tag", "interface", "mandatory");
+		const auto [type, tag, interface, mandatory] = attributes.get<"type", "tag", "interface", "mandatory">();
 
-		info::binaries::device &device = m_devices.emplace_back();
+		info::binaries::device &device = emplaceRecord(m_devices, "devices", m_reallocation_count);
 		binaryWipe(device);
 		device.m_type_strindex			= m_strings.get(type);
 		device.m_tag_strindex			= m_strings.get(tag);
@@ -520,13 +645,13 @@ bool info::database_builder::process_xml(QIODevice &input, QString &error_messag
 	xml.onElementBegin({ "mame", "machine", "device", "instance" }, [this](const XmlParser::Attributes &attributes)
 	{
 		ProfilerScope prof(CURRENT_FUNCTION);
-		const auto [name] = attributes.get("name");
+		const auto [name] = attributes.get<"name">();
 		util::last(m_devices).m_instance_name_strindex = m_strings.get(name);
 	});
 	xml.onElementBegin({ "mame", "machine", "device", "extension" }, [&current_device_extensions](const XmlParser::Attributes &attributes)
 	{
 		ProfilerScope prof(CURRENT_FUNCTION);
-		const auto [name] = attributes.get("name");
+		const auto [name] = attributes.get<"name">();
 
 		if (name)
 		{
@@ -543,7 +668,7 @@ bool info::database_builder::process_xml(QIODevice &input, QString &error_messag
 	xml.onElementBegin({ "mame", "machine", "driver" }, [this](const XmlParser::Attributes &attributes)
 	{
 		ProfilerScope prof(CURRENT_FUNCTION);
-		const auto [status, emulation, cocktail, savestate, unofficial, incomplete] = attributes.get("status", "emulation", "cocktail", "savestate", "unofficial", "incomplete");
+		const auto [status, emulation, cocktail, savestate, unofficial, incomplete] = attributes.get<"status", "emulation", "cocktail", "savestate", "unofficial", "incomplete">();
 
 		info::binaries::machine &machine = util::last(m_machines);
 		machine.m_quality_status		= encodeEnum(status.as<info::machine::driver_quality_t>(s_driver_quality_parser),		machine.m_quality_status);
@@ -556,9 +681,9 @@ bool info::database_builder::process_xml(QIODevice &input, QString &error_messag
 	xml.onElementBegin({ "mame", "machine", "slot" }, [this](const XmlParser::Attributes &attributes)
 	{
 		ProfilerScope prof(CURRENT_FUNCTION);
-		const auto [name] = attributes.get("name");
+		const auto [name] = attributes.get<"name">();
 
-		info::binaries::slot &slot = m_slots.emplace_back();
+		info::binaries::slot &slot = emplaceRecord(m_slots, "slots", m_reallocation_count);
 		binaryWipe(slot);
 		slot.m_name_strindex					= m_strings.get(name);
 		slot.m_slot_options_index				= to_uint32(m_slot_options.size());
@@ -568,21 +693,22 @@ bool info::database_builder::process_xml(QIODevice &input, QString &error_messag
 	xml.onElementBegin({ "mame", "machine", "slot", "slotoption" }, [this](const XmlParser::Attributes &attributes)
 	{
 		ProfilerScope prof(CURRENT_FUNCTION);
-		const auto [name, devname, is_default] = attributes.get("name", "devname", "default");
+		const auto [name, devname, is_default] = attributes.get<"name", "devname", "default">();
 
-		info::binaries::slot_option &slot_option = m_slot_options.emplace_back();
+		info::binaries::slot_option &slot_option = emplaceRecord(m_slot_options, "slot_options", m_reallocation_count);
 		binaryWipe(slot_option);
 		slot_option.m_name_strindex				= m_strings.get(name);
 		slot_option.m_devname_strindex			= m_strings.get(devname);
+		slot_option.m_devname_machindex			= slot_option.m_devname_strindex;	// string index for now; changes to machine index later
 		slot_option.m_is_default				= encodeBool(is_default.as<bool>().value_or(false));
 		util::last(m_slots).m_slot_options_count++;
 	});
 	xml.onElementBegin({ "mame", "machine", "softwarelist" }, [this](const XmlParser::Attributes &attributes)
 	{
 		ProfilerScope prof(CURRENT_FUNCTION);
-		const auto [name, filter, status] = attributes.get("name", "filter", "status");
+		const auto [name, filter, status] = attributes.get<"name", "filter", "status">();
 
-		info::binaries::software_list &software_list = m_software_lists.emplace_back();
+		info::binaries::software_list &software_list = emplaceRecord(m_software_lists, "software_lists", m_reallocation_count);
 		binaryWipe(software_list);
 		software_list.m_name_strindex			= m_strings.get(name);
 		software_list.m_filter_strindex			= m_strings.get(filter);
@@ -592,16 +718,16 @@ bool info::database_builder::process_xml(QIODevice &input, QString &error_messag
 	xml.onElementBegin({ "mame", "machine", "ramoption" }, [this](const XmlParser::Attributes &attributes)
 	{
 		ProfilerScope prof(CURRENT_FUNCTION);
-		const auto [name, is_default] = attributes.get("name", "default");
+		const auto [name, is_default] = attributes.get<"name", "default">();
 
-		info::binaries::ram_option &ram_option = m_ram_options.emplace_back();
+		info::binaries::ram_option &ram_option = emplaceRecord(m_ram_options, "ram_options", m_reallocation_count);
 		binaryWipe(ram_option);
 		ram_option.m_name_strindex				= m_strings.get(name);
 		ram_option.m_is_default					= encodeBool(is_default.as<bool>().value_or(false));
 		ram_option.m_value						= 0;
 		util::last(m_machines).m_ram_options_count++;
 	});
-	xml.onElementEnd({ "mame", "machine", "ramoption" }, [this](std::u8string &&content)
+	xml.onElementEnd({ "mame", "machine", "ramoption" }, [this](std::u8string_view content)
 	{
 		ProfilerScope prof(CURRENT_FUNCTION);
 		bool ok;
@@ -611,7 +737,7 @@ bool info::database_builder::process_xml(QIODevice &input, QString &error_messag
 	xml.onElementBegin({ "mame", "machine", "sound" }, [this](const XmlParser::Attributes &attributes)
 	{
 		ProfilerScope prof(CURRENT_FUNCTION);
-		const auto [channels] = attributes.get("channels");
+		const auto [channels] = attributes.get<"channels">();
 
 		info::binaries::machine &machine = util::last(m_machines);
 		machine.m_sound_channels		= channels.as<std::uint8_t>().value_or(~0);
@@ -637,6 +763,186 @@ bool info::database_builder::process_xml(QIODevice &input, QString &error_messag
 		return false;
 	}
 
+	// success!
+	error_message.clear();
+	return true;
+}
+
+
+//-------------------------------------------------
+//  merge - merges in another builder that parsed
+//	a disjoint shard of the -listxml output; string
+//	indexes are reinterned into our string table,
+//	and machines that we already have (devices are
+//	emitted by every shard that uses them) are
+//	skipped
+//-------------------------------------------------
+
+void info::database_builder::merge(const database_builder &shard) noexcept
+{
+	// sanity check; neither builder can be finalized
+	assert(m_machine_name_buckets.empty());
+	assert(shard.m_machine_name_buckets.empty());
+
+	// helper to move string indexes from the shard's string table to ours
+	auto reintern = [this, &shard](std::uint32_t &strindex)
+	{
+		if (strindex != ~0u)
+		{
+			string_table::SsoBuffer ssoBuffer;
+			strindex = m_strings.get(shard.m_strings.lookup(strindex, ssoBuffer));
+		}
+	};
+
+	// the build comes from the <mame> element, which we will not have seen if our shard was empty
+	if (m_build_strindex == 0)
+	{
+		m_build_strindex = shard.m_build_strindex;
+		if (m_build_strindex != 0)
+			reintern(m_build_strindex);
+	}
+
+	// the shard's shortfalls in the capacity plan are ours too
+	m_reallocation_count += shard.m_reallocation_count;
+
+	// identify the machines we already have
+	std::unordered_set<std::uint32_t> machineNames;
+	machineNames.reserve(m_machines.size() + shard.m_machines.size());
+	for (const info::binaries::machine &machine : m_machines)
+		machineNames.insert(machine.m_name_strindex);
+
+	// and append the shard's machines, along with all of their records
+	m_machines.reserve(m_machines.size() + shard.m_machines.size());
+	for (const info::binaries::machine &shardMachine : shard.m_machines)
+	{
+		info::binaries::machine machine = shardMachine;
+		reintern(machine.m_name_strindex);
+		if (!machineNames.insert(machine.m_name_strindex).second)
+			continue;
+
+		reintern(machine.m_sourcefile_strindex);
+		reintern(machine.m_clone_of_machindex);		// still a string index
+		reintern(machine.m_rom_of_machindex);		// still a string index
+		reintern(machine.m_description_strindex);
+		reintern(machine.m_year_strindex);
+		reintern(machine.m_manufacturer_strindex);
+
+		machine.m_biossets_index = appendRange(m_biossets, shard.m_biossets, machine.m_biossets_index, machine.m_biossets_count, [&reintern](info::binaries::biosset &biosset)
+		{
+			reintern(biosset.m_name_strindex);
+			reintern(biosset.m_description_strindex);
+		});
+		machine.m_roms_index = appendRange(m_roms, shard.m_roms, machine.m_roms_index, machine.m_roms_count, [&reintern](info::binaries::rom &rom)
+		{
+			reintern(rom.m_name_strindex);
+			reintern(rom.m_bios_strindex);
+			reintern(rom.m_merge_strindex);
+			reintern(rom.m_region_strindex);
+		});
+		machine.m_disks_index = appendRange(m_disks, shard.m_disks, machine.m_disks_index, machine.m_disks_count, [&reintern](info::binaries::disk &disk)
+		{
+			reintern(disk.m_name_strindex);
+			reintern(disk.m_merge_strindex);
+			reintern(disk.m_region_strindex);
+		});
+		machine.m_features_index = appendRange(m_features, shard.m_features, machine.m_features_index, machine.m_features_count, [](info::binaries::feature &)
+		{
+		});
+		machine.m_chips_index = appendRange(m_chips, shard.m_chips, machine.m_chips_index, machine.m_chips_count, [&reintern](info::binaries::chip &chip)
+		{
+			reintern(chip.m_name_strindex);
+			reintern(chip.m_tag_strindex);
+		});
+		machine.m_displays_index = appendRange(m_displays, shard.m_displays, machine.m_displays_index, machine.m_displays_count, [&reintern](info::binaries::display &display)
+		{
+			reintern(display.m_tag_strindex);
+		});
+		machine.m_samples_index = appendRange(m_samples, shard.m_samples, machine.m_samples_index, machine.m_samples_count, [&reintern](info::binaries::sample &sample)
+		{
+			reintern(sample.m_name_strindex);
+		});
+		machine.m_configurations_index = appendRange(m_configurations, shard.m_configurations, machine.m_configurations_index, machine.m_configurations_count, [this, &shard, &reintern](info::binaries::configuration &configuration)
+		{
+			reintern(configuration.m_name_strindex);
+			reintern(configuration.m_tag_strindex);
+
+			std::uint32_t settingsIndex = configuration.m_configuration_settings_index;
+			configuration.m_configuration_settings_index = to_uint32(m_configuration_settings.size());
+			for (std::uint32_t i = settingsIndex; i < settingsIndex + configuration.m_configuration_settings_count; i++)
+			{
+				info::binaries::configuration_setting &setting = m_configuration_settings.emplace_back(shard.m_configuration_settings[i]);
+				reintern(setting.m_name_strindex);
+
+				// a setting's conditions run until the next setting's conditions start
+				std::uint32_t conditionsEnd = i + 1 < shard.m_configuration_settings.size()
+					? shard.m_configuration_settings[i + 1].m_conditions_index
+					: to_uint32(shard.m_configuration_conditions.size());
+				setting.m_conditions_index = appendRange(m_configuration_conditions, shard.m_configuration_conditions, setting.m_conditions_index, conditionsEnd - setting.m_conditions_index, [&reintern](info::binaries::configuration_condition &condition)
+				{
+					reintern(condition.m_tag_strindex);
+				});
+			}
+		});
+		machine.m_software_lists_index = appendRange(m_software_lists, shard.m_software_lists, machine.m_software_lists_index, machine.m_software_lists_count, [&reintern](info::binaries::software_list &software_list)
+		{
+			reintern(software_list.m_name_strindex);
+			reintern(software_list.m_filter_strindex);
+		});
+		machine.m_ram_options_index = appendRange(m_ram_options, shard.m_ram_options, machine.m_ram_options_index, machine.m_ram_options_count, [&reintern](info::binaries::ram_option &ram_option)
+		{
+			reintern(ram_option.m_name_strindex);
+		});
+		machine.m_devices_index = appendRange(m_devices, shard.m_devices, machine.m_devices_index, machine.m_devices_count, [&reintern](info::binaries::device &device)
+		{
+			reintern(device.m_type_strindex);
+			reintern(device.m_tag_strindex);
+			reintern(device.m_interface_strindex);
+			reintern(device.m_instance_name_strindex);
+			reintern(device.m_extensions_strindex);
+		});
+		machine.m_slots_index = appendRange(m_slots, shard.m_slots, machine.m_slots_index, machine.m_slots_count, [this, &shard, &reintern](info::binaries::slot &slot)
+		{
+			reintern(slot.m_name_strindex);
+			slot.m_slot_options_index = appendRange(m_slot_options, shard.m_slot_options, slot.m_slot_options_index, slot.m_slot_options_count, [&reintern](info::binaries::slot_option &slot_option)
+			{
+				reintern(slot_option.m_name_strindex);
+				reintern(slot_option.m_devname_strindex);
+				reintern(slot_option.m_devname_machindex);	// still a string index
+			});
+		});
+
+		m_machines.push_back(machine);
+	}
+}
+
+
+//-------------------------------------------------
+//  finalize - builds everything else once all of
+//	the -listxml output is parsed
+//-------------------------------------------------
+
+void info::database_builder::finalize() noexcept
+{
+	// sanity check; ensure we're not already finalized
+	assert(m_machine_name_buckets.empty());
+
+	// prepare header and magic variables
+	info::binaries::header header = { 0, };
+	header.m_magic = info::binaries::MAGIC_HDR;
+	header.m_sizes_hash = info::database::calculate_sizes_hash();
+	header.m_build_strindex = m_build_strindex;
+
+	// the cold tables are now complete; compress them in the background while we build everything else (the
+	// order needs to match what info::database expects)
+	std::future<void> compressionFuture = std::async(std::launch::async, [this]
+	{
+		compressColdTable(m_chips);
+		compressColdTable(m_displays);
+		compressColdTable(m_configurations);
+		compressColdTable(m_configuration_settings);
+		compressColdTable(m_configuration_conditions);
+	});
+
 	// final magic bytes on string table
 	m_strings.embed_value(info::binaries::MAGIC_STRINGTABLE_END);
 
@@ -658,9 +964,6 @@ bool info::database_builder::process_xml(QIODevice &input, QString &error_messag
 	header.m_software_lists_count			= to_uint32(m_software_lists.size());
 	header.m_ram_options_count				= to_uint32(m_ram_options.size());
 
-	// and salt it
-	m_salted_header = util::salt(header, info::binaries::salt());
-
 	// sort machines by name to facilitate lookups
 	std::sort(
 		m_machines.begin(),
@@ -698,9 +1001,423 @@ bool info::database_builder::process_xml(QIODevice &input, QString &error_messag
 		machine.m_rom_of_machindex = machineIndexFromStringIndex(machine.m_rom_of_machindex);
 	}
 
-	// success!
-	error_message.clear();
-	return true;
+	// likewise for slot option device names
+	for (info::binaries::slot_option &slot_option : m_slot_options)
+		slot_option.m_devname_machindex = machineIndexFromStringIndex(slot_option.m_devname_machindex);
+
+	// build the machine name index
+	buildMachineNameIndex();
+	header.m_machine_name_buckets_count = to_uint32(m_machine_name_buckets.size());
+
+	// build the clone and romof children, and the machine groups (used for folders); both
+	// of these emit into the machine references table
+	m_machine_groups.clear();
+	m_machine_references.clear();
+	buildMachineChildren();
+	buildMachineGroups(header);
+
+	// build the indexes used to identify ROMs and disks by their hashes
+	buildHashIndexes();
+	header.m_roms_by_crc_count = to_uint32(m_roms_by_crc.size());
+	header.m_disks_by_sha1_count = to_uint32(m_disks_by_sha1.size());
+
+	// build the per-machine indexes used to find devices and chips
+	buildLookupIndexes();
+
+	// wait for the cold tables to be compressed
+	compressionFuture.wait();
+	header.m_compressed_blocks_count = to_uint32(m_compressed_blocks.size());
+	header.m_compressed_data_size = to_uint32(m_compressed_data.size());
+
+	// and salt the header
+	m_salted_header = util::salt(header, info::binaries::salt());
+}
+
+
+//-------------------------------------------------
+//  buildMachineNameIndex - builds a minimal perfect
+//	hash (hash and displace) of machine names, so
+//	that find_machine() can do a lookup with a
+//	single string comparison
+//-------------------------------------------------
+
+void info::database_builder::buildMachineNameIndex()
+{
+	ProfilerScope prof(CURRENT_FUNCTION);
+
+	// one bucket for every two machines; each bucket will have a seed that will
+	// map all of its machines into distinct slots
+	std::size_t slotCount = m_machines.size();
+	std::size_t bucketCount = (slotCount + 1) / 2;
+	const std::uint32_t emptySlot = ~0u;
+	m_machine_name_buckets.assign(bucketCount, 0);
+	m_machine_name_slots.assign(slotCount, emptySlot);
+
+	// gather up the names and put them into buckets; machines are sorted so duplicates (which
+	// should never happen unless -listxml is returning bad results) are adjacent and we only
+	// index the first
+	std::vector<std::u8string_view> names;
+	std::vector<string_table::SsoBuffer> ssoBuffers(slotCount);
+	std::vector<std::vector<std::uint32_t>> buckets(bucketCount);
+	names.reserve(slotCount);
+	for (std::uint32_t i = 0; i < slotCount; i++)
+	{
+		names.emplace_back(m_strings.lookup(m_machines[i].m_name_strindex, ssoBuffers[i]));
+		if (i == 0 || names[i] != names[i - 1])
+			buckets[info::database::machine_name_hash(names[i], 0) % bucketCount].push_back(i);
+	}
+
+	// place the largest buckets first
+	std::vector<std::uint32_t> bucketOrder(bucketCount);
+	std::iota(bucketOrder.begin(), bucketOrder.end(), 0);
+	std::stable_sort(bucketOrder.begin(), bucketOrder.end(), [&buckets](std::uint32_t a, std::uint32_t b)
+	{
+		return buckets[a].size() > buckets[b].size();
+	});
+
+	std::vector<std::uint32_t> candidateSlots;
+	std::uint32_t freeSlotCursor = 0;
+	for (std::uint32_t bucketIndex : bucketOrder)
+	{
+		const std::vector<std::uint32_t> &bucket = buckets[bucketIndex];
+		if (bucket.empty())
+		{
+			// all remaining buckets are empty
+			break;
+		}
+		else if (bucket.size() == 1)
+		{
+			// singleton buckets can point directly at any free slot
+			while (m_machine_name_slots[freeSlotCursor] != emptySlot)
+				freeSlotCursor++;
+			m_machine_name_buckets[bucketIndex] = 0x80000000 | freeSlotCursor;
+			m_machine_name_slots[freeSlotCursor] = bucket[0];
+		}
+		else
+		{
+			// try seeds until we find one that places everything in this bucket into free slots
+			std::uint32_t seed = 0;
+			do
+			{
+				seed++;
+				candidateSlots.clear();
+				for (std::uint32_t machineIndex : bucket)
+				{
+					std::uint32_t slot = info::database::machine_name_hash(names[machineIndex], seed) % slotCount;
+					if (m_machine_name_slots[slot] != emptySlot || std::ranges::find(candidateSlots, slot) != candidateSlots.end())
+						break;
+					candidateSlots.push_back(slot);
+				}
+			} while (candidateSlots.size() != bucket.size());
+
+			m_machine_name_buckets[bucketIndex] = seed;
+			for (std::size_t i = 0; i < bucket.size(); i++)
+				m_machine_name_slots[candidateSlots[i]] = bucket[i];
+		}
+	}
+}
+
+
+//-------------------------------------------------
+//  buildMachineChildren - builds the lists of
+//	clones and romof dependents of each machine
+//-------------------------------------------------
+
+void info::database_builder::buildMachineChildren()
+{
+	ProfilerScope prof(CURRENT_FUNCTION);
+
+	// count the children
+	for (const info::binaries::machine &machine : m_machines)
+	{
+		if (machine.m_clone_of_machindex < m_machines.size())
+			m_machines[machine.m_clone_of_machindex].m_clones_count++;
+		if (machine.m_rom_of_machindex < m_machines.size())
+			m_machines[machine.m_rom_of_machindex].m_dependents_count++;
+	}
+
+	// lay out space for the children in the references table
+	std::size_t cursor = m_machine_references.size();
+	for (info::binaries::machine &machine : m_machines)
+	{
+		machine.m_clones_index = to_uint32(cursor);
+		cursor += machine.m_clones_count;
+		machine.m_dependents_index = to_uint32(cursor);
+		cursor += machine.m_dependents_count;
+		machine.m_clones_count = 0;
+		machine.m_dependents_count = 0;
+	}
+	m_machine_references.resize(cursor);
+
+	// and fill them in; because we iterate in order, the children are sorted by machine index
+	for (std::uint32_t machineIndex = 0; machineIndex < m_machines.size(); machineIndex++)
+	{
+		const info::binaries::machine &machine = m_machines[machineIndex];
+		if (machine.m_clone_of_machindex < m_machines.size())
+		{
+			info::binaries::machine &parent = m_machines[machine.m_clone_of_machindex];
+			m_machine_references[parent.m_clones_index + parent.m_clones_count++].m_machindex = machineIndex;
+		}
+		if (machine.m_rom_of_machindex < m_machines.size())
+		{
+			info::binaries::machine &parent = m_machines[machine.m_rom_of_machindex];
+			m_machine_references[parent.m_dependents_index + parent.m_dependents_count++].m_machindex = machineIndex;
+		}
+	}
+}
+
+
+//-------------------------------------------------
+//  buildMachineGroups - builds inverted indexes
+//	of runnable machines by manufacturer, year,
+//	source file, chips and BIOS
+//-------------------------------------------------
+
+void info::database_builder::buildMachineGroups(info::binaries::header &header)
+{
+	ProfilerScope prof(CURRENT_FUNCTION);
+
+	// gather up (key, machine index) pairs for all runnable machines
+	std::vector<std::pair<std::uint32_t, std::uint32_t>> manufacturers, years, sourceFiles, cpus, sounds, bioses;
+	for (std::uint32_t machineIndex = 0; machineIndex < m_machines.size(); machineIndex++)
+	{
+		const info::binaries::machine &machine = m_machines[machineIndex];
+		if (!machine.m_runnable)
+			continue;
+
+		// manufacturer/source/year
+		manufacturers.emplace_back(machine.m_manufacturer_strindex, machineIndex);
+		years.emplace_back(machine.m_year_strindex, machineIndex);
+		sourceFiles.emplace_back(machine.m_sourcefile_strindex, machineIndex);
+
+		// cpu/sound
+		for (std::uint32_t i = 0; i < machine.m_chips_count; i++)
+		{
+			const info::binaries::chip &chip = m_chips[machine.m_chips_index + i];
+			switch ((info::chip::type_t)chip.m_type)
+			{
+			case info::chip::type_t::CPU:
+				cpus.emplace_back(chip.m_name_strindex, machineIndex);
+				break;
+
+			case info::chip::type_t::AUDIO:
+				sounds.emplace_back(chip.m_name_strindex, machineIndex);
+				break;
+
+			default:
+				// ignore anything we don't know about
+				break;
+			}
+		}
+
+		// BIOS; the root of the clone chain must be a romof of a BIOS
+		const info::binaries::machine *rootMachine = &machine;
+		while (rootMachine->m_clone_of_machindex < m_machines.size())
+			rootMachine = &m_machines[rootMachine->m_clone_of_machindex];
+		if (rootMachine->m_rom_of_machindex < m_machines.size())
+		{
+			const info::binaries::machine &biosMachine = m_machines[rootMachine->m_rom_of_machindex];
+			if (biosMachine.m_is_bios == encodeBool(true))
+				bioses.emplace_back(biosMachine.m_name_strindex, machineIndex);
+		}
+	}
+
+	// and emit them all
+	header.m_manufacturer_groups_count	= emitMachineGroups(std::move(manufacturers));
+	header.m_year_groups_count			= emitMachineGroups(std::move(years));
+	header.m_sourcefile_groups_count	= emitMachineGroups(std::move(sourceFiles));
+	header.m_cpu_groups_count			= emitMachineGroups(std::move(cpus));
+	header.m_sound_groups_count			= emitMachineGroups(std::move(sounds));
+	header.m_bios_groups_count			= emitMachineGroups(std::move(bioses));
+	header.m_machine_references_count	= to_uint32(m_machine_references.size());
+}
+
+
+//-------------------------------------------------
+//  emitMachineGroups - emits groups sorted by key
+//	text; machines within a group are sorted by
+//	machine index
+//-------------------------------------------------
+
+std::uint32_t info::database_builder::emitMachineGroups(std::vector<std::pair<std::uint32_t, std::uint32_t>> &&keyedMachines)
+{
+	// sort by the text of the key, and then by machine index; identical strings always have the same string index
+	std::ranges::sort(keyedMachines, [this](const std::pair<std::uint32_t, std::uint32_t> &a, const std::pair<std::uint32_t, std::uint32_t> &b)
+	{
+		if (a.first == b.first)
+			return a.second < b.second;
+
+		string_table::SsoBuffer ssoBufferA, ssoBufferB;
+		std::u8string_view aText = m_strings.lookup(a.first, ssoBufferA);
+		std::u8string_view bText = m_strings.lookup(b.first, ssoBufferB);
+		return aText < bText;
+	});
+
+	// machines can have more than one chip of a given name
+	auto duplicates = std::ranges::unique(keyedMachines);
+	keyedMachines.erase(duplicates.begin(), duplicates.end());
+
+	// and emit the groups
+	std::uint32_t groupCount = 0;
+	for (auto iter = keyedMachines.begin(); iter != keyedMachines.end(); )
+	{
+		info::binaries::machine_group &group = m_machine_groups.emplace_back();
+		binaryWipe(group);
+		group.m_name_strindex				= iter->first;
+		group.m_machine_references_index	= to_uint32(m_machine_references.size());
+		group.m_machine_references_count	= 0;
+		groupCount++;
+
+		for (; iter != keyedMachines.end() && iter->first == group.m_name_strindex; iter++)
+		{
+			info::binaries::machine_reference &reference = m_machine_references.emplace_back();
+			binaryWipe(reference);
+			reference.m_machindex = iter->second;
+			group.m_machine_references_count++;
+		}
+	}
+	return groupCount;
+}
+
+
+//-------------------------------------------------
+//  buildHashIndexes - builds indexes of ROMs by
+//	CRC32 and disks by SHA-1, so that media can be
+//	identified by content
+//-------------------------------------------------
+
+void info::database_builder::buildHashIndexes()
+{
+	ProfilerScope prof(CURRENT_FUNCTION);
+
+	for (std::uint32_t machindex = 0; machindex < m_machines.size(); machindex++)
+	{
+		const info::binaries::machine &machine = m_machines[machindex];
+
+		// ROMs; nodumps don't have a CRC32
+		for (std::uint32_t romIndex = machine.m_roms_index; romIndex < machine.m_roms_index + machine.m_roms_count; romIndex++)
+		{
+			const info::binaries::rom &rom = m_roms[romIndex];
+			if (rom.m_status != (std::uint8_t)info::rom::dump_status_t::NODUMP)
+			{
+				info::binaries::rom_by_crc &romByCrc = m_roms_by_crc.emplace_back();
+				romByCrc.m_crc32		= ((std::uint32_t)rom.m_crc32[0]) << 24
+										| ((std::uint32_t)rom.m_crc32[1]) << 16
+										| ((std::uint32_t)rom.m_crc32[2]) << 8
+										| ((std::uint32_t)rom.m_crc32[3]) << 0;
+				romByCrc.m_rom_index	= romIndex;
+				romByCrc.m_machindex	= machindex;
+			}
+		}
+
+		// disks; likewise nodumps don't have a SHA-1
+		for (std::uint32_t diskIndex = machine.m_disks_index; diskIndex < machine.m_disks_index + machine.m_disks_count; diskIndex++)
+		{
+			const info::binaries::disk &disk = m_disks[diskIndex];
+			if (disk.m_status != (std::uint8_t)info::rom::dump_status_t::NODUMP)
+			{
+				info::binaries::disk_by_sha1 &diskBySha1 = m_disks_by_sha1.emplace_back();
+				std::copy(std::begin(disk.m_sha1), std::end(disk.m_sha1), diskBySha1.m_sha1);
+				diskBySha1.m_disk_index	= diskIndex;
+				diskBySha1.m_machindex	= machindex;
+			}
+		}
+	}
+
+	// and sort them
+	std::ranges::sort(m_roms_by_crc, [](const info::binaries::rom_by_crc &a, const info::binaries::rom_by_crc &b)
+	{
+		return std::tie(a.m_crc32, a.m_rom_index) < std::tie(b.m_crc32, b.m_rom_index);
+	});
+	std::ranges::sort(m_disks_by_sha1, [](const info::binaries::disk_by_sha1 &a, const info::binaries::disk_by_sha1 &b)
+	{
+		int rc = memcmp(a.m_sha1, b.m_sha1, sizeof(a.m_sha1));
+		return rc != 0 ? rc < 0 : a.m_disk_index < b.m_disk_index;
+	});
+}
+
+
+//-------------------------------------------------
+//  buildLookupIndexes - builds indexes of each
+//	machine's devices (by tag) and chips (by name)
+//	so that they can be binary searched
+//-------------------------------------------------
+
+void info::database_builder::buildLookupIndexes()
+{
+	ProfilerScope prof(CURRENT_FUNCTION);
+
+	m_devices_by_tag.resize(m_devices.size());
+	m_chips_by_name.resize(m_chips.size());
+	for (const info::binaries::machine &machine : m_machines)
+	{
+		buildSortedIndex(m_devices_by_tag, machine.m_devices_index, machine.m_devices_count, [this](std::uint32_t i) { return m_devices[i].m_tag_strindex; });
+		buildSortedIndex(m_chips_by_name, machine.m_chips_index, machine.m_chips_count, [this](std::uint32_t i) { return m_chips[i].m_name_strindex; });
+	}
+}
+
+
+//-------------------------------------------------
+//  buildSortedIndex - populates a range of an index
+//	with item indexes sorted by string; ties are
+//	broken by position so lookups find the first
+//-------------------------------------------------
+
+template<typename TFunc>
+void info::database_builder::buildSortedIndex(std::vector<std::uint32_t> &sorted, std::uint32_t index, std::uint32_t count, TFunc strindexFunc)
+{
+	auto begin = sorted.begin() + index;
+	auto end = begin + count;
+	std::iota(begin, end, index);
+	std::stable_sort(begin, end, [this, &strindexFunc](std::uint32_t a, std::uint32_t b)
+	{
+		string_table::SsoBuffer ssoBufferA, ssoBufferB;
+		std::u8string_view aText = m_strings.lookup(strindexFunc(a), ssoBufferA);
+		std::u8string_view bText = m_strings.lookup(strindexFunc(b), ssoBufferB);
+		return aText < bText;
+	});
+}
+
+
+//-------------------------------------------------
+//  compressColdTable - compresses a table that is
+//	rarely accessed as a series of blocks that can
+//	be decompressed independently
+//-------------------------------------------------
+
+template<typename T>
+void info::database_builder::compressColdTable(const std::vector<T> &table)
+{
+	// small tables are not worth the trouble; their blocks are stored raw
+	bool shouldCompress = table.size() * sizeof(T) >= m_compressionThreshold;
+
+	std::size_t blockSize = info::database::ColdTable::blockSize(sizeof(T));
+	std::span<const std::uint8_t> tableData((const std::uint8_t *)table.data(), table.size() * sizeof(T));
+	std::vector<std::uint8_t> buffer;
+	for (std::size_t offset = 0; offset < tableData.size(); offset += blockSize)
+	{
+		std::span<const std::uint8_t> rawData = tableData.subspan(offset, std::min(blockSize, tableData.size() - offset));
+
+		info::binaries::compressed_block &block = m_compressed_blocks.emplace_back();
+		block.m_offset = to_uint32(m_compressed_data.size());
+
+		uLongf compressedSize = 0;
+		if (shouldCompress)
+		{
+			buffer.resize(compressBound(util::safe_static_cast<uLong>(rawData.size())));
+			compressedSize = util::safe_static_cast<uLongf>(buffer.size());
+			if (compress2(buffer.data(), &compressedSize, rawData.data(), util::safe_static_cast<uLong>(rawData.size()), Z_BEST_COMPRESSION) != Z_OK)
+				compressedSize = 0;
+		}
+
+		// only keep the compressed data if it actually helps; a block whose size matches its
+		// raw size is understood to be stored raw
+		if (compressedSize > 0 && compressedSize < rawData.size())
+			m_compressed_data.insert(m_compressed_data.end(), buffer.begin(), buffer.begin() + compressedSize);
+		else
+			m_compressed_data.insert(m_compressed_data.end(), rawData.begin(), rawData.end());
+		block.m_size = to_uint32(m_compressed_data.size() - block.m_offset);
+	}
 }
 
 
@@ -719,14 +1436,19 @@ void info::database_builder::emit_info(QIODevice &output) const noexcept
 	writeContainerData(output, m_slots);
 	writeContainerData(output, m_slot_options);
 	writeContainerData(output, m_features);
-	writeContainerData(output, m_chips);
-	writeContainerData(output, m_displays);
 	writeContainerData(output, m_samples);
-	writeContainerData(output, m_configurations);
-	writeContainerData(output, m_configuration_settings);
-	writeContainerData(output, m_configuration_conditions);
 	writeContainerData(output, m_software_lists);
 	writeContainerData(output, m_ram_options);
+	writeContainerData(output, m_machine_name_buckets);
+	writeContainerData(output, m_machine_name_slots);
+	writeContainerData(output, m_machine_groups);
+	writeContainerData(output, m_machine_references);
+	writeContainerData(output, m_roms_by_crc);
+	writeContainerData(output, m_disks_by_sha1);
+	writeContainerData(output, m_devices_by_tag);
+	writeContainerData(output, m_chips_by_name);
+	writeContainerData(output, m_compressed_blocks);
+	writeContainerData(output, m_compressed_data);
 	writeContainerData(output, m_strings.data());
 }
 
@@ -740,8 +1462,7 @@ void info::database_builder::dump() const noexcept
 {
 	dumpTableSizes();
 	m_strings.dumpStringSizeDistribution();
-	m_strings.dumpPrimaryBucketDistribution();
-	m_strings.dumpSecondaryBucketDistribution();
+	m_strings.dumpProbeLengthDistribution();
 }
 
 
@@ -768,6 +1489,13 @@ void info::database_builder::dumpTableSizes() const noexcept
 	printf("m_configuration_conditions.size(): %7lu\n", (unsigned long)m_configuration_conditions.size());
 	printf("m_software_lists.size():           %7lu\n", (unsigned long)m_software_lists.size());
 	printf("m_ram_options.size():              %7lu\n", (unsigned long)m_ram_options.size());
+	printf("m_machine_name_buckets.size():     %7lu\n", (unsigned long)m_machine_name_buckets.size());
+	printf("m_machine_groups.size():           %7lu\n", (unsigned long)m_machine_groups.size());
+	printf("m_machine_references.size():       %7lu\n", (unsigned long)m_machine_references.size());
+	printf("m_roms_by_crc.size():              %7lu\n", (unsigned long)m_roms_by_crc.size());
+	printf("m_disks_by_sha1.size():            %7lu\n", (unsigned long)m_disks_by_sha1.size());
+	printf("m_compressed_blocks.size():        %7lu\n", (unsigned long)m_compressed_blocks.size());
+	printf("m_compressed_data.size():          %7lu\n", (unsigned long)m_compressed_data.size());
 	printf("m_strings.data().size():           %7lu\n", (unsigned long)m_strings.data().size());
 }
 
@@ -777,6 +1505,7 @@ void info::database_builder::dumpTableSizes() const noexcept
 //-------------------------------------------------
 
 info::database_builder::string_table::string_table() noexcept
+	: m_slotsUsed(0)
 {
 	// reserve space based on expected size (see comments above)
 	m_data.reserve(4500000);		// 4326752 bytes
@@ -784,10 +1513,8 @@ info::database_builder::string_table::string_table() noexcept
 	// embed the initial magic bytes
 	embed_value(info::binaries::MAGIC_STRINGTABLE_BEGIN);
 
-	// allocate the map buckets
-	m_primaryMapBuckets = std::make_unique<decltype(m_primaryMapBuckets)::element_type>();
-	std::ranges::fill(*m_primaryMapBuckets, 0);
-	m_secondaryMapBuckets.reserve(60000);
+	// start with a modest hash table; it grows as needed
+	m_slots.resize(65536, Slot { 0, 0 });
 }
 
 
@@ -803,65 +1530,94 @@ void info::database_builder::string_table::shrinkToFit() noexcept
 
 
 //-------------------------------------------------
-//  string_table::findBucket
+//  string_table::hash - a simple word-at-a-time
+//	hash; this does not need to be stable across
+//	platforms because it never ends up in the info
+//	DB
 //-------------------------------------------------
 
-std::uint32_t &info::database_builder::string_table::findBucket(std::u8string_view s)
+std::uint32_t info::database_builder::string_table::hash(std::u8string_view s) noexcept
 {
-	// hash the string to find the primary bucket
-	std::size_t stringHash = std::hash<std::u8string_view>{}(s);
-	std::uint32_t &primaryBucket = (*m_primaryMapBuckets)[stringHash % m_primaryMapBuckets->size()];
+	const std::uint64_t multiplier = 0x9E3779B97F4A7C15;
 
-	// local function to determine if this ID is the target
-	const auto isTargetString = [this, &s](std::uint32_t candidateId)
+	// mix in each 64-bit word
+	std::uint64_t result = s.size() * multiplier;
+	std::size_t position = 0;
+	while (position < s.size())
 	{
-		return (size_t)candidateId + s.size() + 1 <= m_data.size()
-			&& !memcmp(s.data(), &m_data[candidateId], s.size())
-			&& m_data[candidateId + s.size()] == '\0';
-	};
+		std::uint64_t word = 0;
+		std::size_t wordSize = std::min(s.size() - position, sizeof(word));
+		memcpy(&word, s.data() + position, wordSize);
+		result = std::rotl(result ^ word, 29) * multiplier;
+		position += wordSize;
+	}
 
-	SecondaryMapBucket *targetSecondaryBucket = nullptr;
-	std::uint32_t *targetBucket = nullptr;
-	if ((primaryBucket & 0xC0000000) == 0xC0000000)
-	{
-		// this is a secondary bucket
-		SecondaryMapBucket &secondaryBucket = m_secondaryMapBuckets[primaryBucket & ~0xC0000000];
+	// and avalanche (this is the MurmurHash3 finalizer)
+	result ^= result >> 33;
+	result *= 0xFF51AFD7ED558CCD;
+	result ^= result >> 33;
+	result *= 0xC4CEB9FE1A85EC53;
+	result ^= result >> 33;
+	return (std::uint32_t)result;
+}
 
-		// find the target
-		auto iter = std::ranges::find_if(secondaryBucket, isTargetString);
-		if (iter != secondaryBucket.end())
-			targetBucket = &*iter;
-		else
-			targetSecondaryBucket = &secondaryBucket;
-	}
-	else if (primaryBucket == 0 || isTargetString(primaryBucket))
+
+//-------------------------------------------------
+//  string_table::findSlot - finds the slot for a
+//	string; if the string is not present, this is
+//	the (empty) slot where it belongs
+//-------------------------------------------------
+
+info::database_builder::string_table::Slot &info::database_builder::string_table::findSlot(std::u8string_view s)
+{
+	// keep the load factor at or below 3/4, so that probes stay short
+	if ((m_slotsUsed + 1) * 4 > m_slots.size() * 3)
+		growSlots();
+
+	// probe until we find the string or an empty slot; the hash check lets us skip almost all
+	// string comparisons
+	std::uint32_t stringHash = hash(s);
+	std::size_t mask = m_slots.size() - 1;
+	std::size_t index = stringHash & mask;
+	while (m_slots[index].m_position != 0)
 	{
-		// the target is this primary bucket
-		targetBucket = &primaryBucket;
+		const Slot &slot = m_slots[index];
+		if (slot.m_hash == stringHash
+			&& (size_t)slot.m_position + s.size() + 1 <= m_data.size()
+			&& !memcmp(s.data(), &m_data[slot.m_position], s.size())
+			&& m_data[slot.m_position + s.size()] == '\0')
+		{
+			return m_slots[index];
+		}
+		index = (index + 1) & mask;
 	}
-	else
-	{
-		// we need to change a primary bucket to a secondary bucket
-		std::uint32_t newPrimaryBucketValue = 0xC0000000 | to_uint32(m_secondaryMapBuckets.size());
 
-		// add the secondary bucket
-		targetSecondaryBucket = &*m_secondaryMapBuckets.emplace(m_secondaryMapBuckets.end());
+	// not found; claim this slot for the caller
+	m_slots[index].m_hash = stringHash;
+	return m_slots[index];
+}
 
-		// perform the move
-		targetSecondaryBucket->push_front(primaryBucket);
-		primaryBucket = newPrimaryBucketValue;
-	}
 
-	// do we need to add to the secondary bucket?
-	if (targetSecondaryBucket)
+//-------------------------------------------------
+//  string_table::growSlots - doubles the size of
+//	the hash table; because we keep the hashes we
+//	never need to look at the strings themselves
+//-------------------------------------------------
+
+void info::database_builder::string_table::growSlots()
+{
+	std::vector<Slot> oldSlots = std::exchange(m_slots, std::vector<Slot>(m_slots.size() * 2, Slot { 0, 0 }));
+	std::size_t mask = m_slots.size() - 1;
+	for (const Slot &slot : oldSlots)
 	{
-		targetSecondaryBucket->push_front(0);
-		targetBucket = &targetSecondaryBucket->front();
+		if (slot.m_position != 0)
+		{
+			std::size_t index = slot.m_hash & mask;
+			while (m_slots[index].m_position != 0)
+				index = (index + 1) & mask;
+			m_slots[index] = slot;
+		}
 	}
-
-	// and return
-	assert(targetBucket);
-	return *targetBucket;
 }
 
 
@@ -869,17 +1625,14 @@ std::uint32_t &info::database_builder::string_table::findBucket(std::u8string_vi
 //  string_table::internalGet
 //-------------------------------------------------
 
-std::uint32_t info::database_builder::string_table::internalGet(std::span<const char8_t> string)
+std::uint32_t info::database_builder::string_table::internalGet(std::u8string_view string)
 {
-	// sanity check - we expect string to be a NUL-terminated string
-	assert(std::find(string.begin(), string.end(), '\0') - string.begin() + 1 == string.size());
-
-	// with that out of the way, set up a string view
-	std::u8string_view stringView(string.data(), string.size() - 1);
+	// sanity check - we can't have embedded NULs
+	assert(string.find(u8'\0') == std::u8string_view::npos);
 
 	// try encoding as a small string
 	std::uint32_t result;
-	std::optional<std::uint32_t> ssoResult = info::database::tryEncodeAsSmallString(stringView);
+	std::optional<std::uint32_t> ssoResult = info::database::tryEncodeAsSmallString(string);
 	if (ssoResult)
 	{
 		// it was a small string!
@@ -887,20 +1640,22 @@ std::uint32_t info::database_builder::string_table::internalGet(std::span<const
 	}
 	else
 	{
-		// find the bucket
-		std::uint32_t &bucket = findBucket(stringView);
+		// find the slot
+		Slot &slot = findSlot(string);
 
 		// did we find it?
-		if (bucket == 0)
+		if (slot.m_position == 0)
 		{
 			// we're going to append the string; the current size becomes the position of the new string
-			bucket = to_uint32(m_data.size());
+			slot.m_position = to_uint32(m_data.size());
+			m_slotsUsed++;
 
 			// append the string to m_data (but keep track of where we are)
 			m_data.insert(m_data.end(), string.begin(), string.end());
+			m_data.push_back(u8'\0');
 		}
 
-		result = bucket;
+		result = slot.m_position;
 	}
 
 	// and return
@@ -914,19 +1669,17 @@ std::uint32_t info::database_builder::string_table::internalGet(std::span<const
 
 std::uint32_t info::database_builder::string_table::get(const char8_t *string) noexcept
 {
-	std::span<const char8_t> stringSpan(string, strlen((const char *)string) + 1);
-	return internalGet(stringSpan);
+	return internalGet(std::u8string_view(string));
 }
 
 
 //-------------------------------------------------
-//  string_table::get(const std::u8string &string)
+//  string_table::get(std::u8string_view string)
 //-------------------------------------------------
 
-std::uint32_t info::database_builder::string_table::get(const std::u8string &string) noexcept
+std::uint32_t info::database_builder::string_table::get(std::u8string_view string) noexcept
 {
-	std::span<const char8_t> stringSpan(string.data(), string.size() + 1);
-	return internalGet(stringSpan);
+	return internalGet(string);
 }
 
 
@@ -1047,52 +1800,25 @@ void info::database_builder::string_table::dumpStringSizeDistribution() const no
 
 
 //-------------------------------------------------
-//  string_table::dumpPrimaryBucketDistribution
+//  string_table::dumpProbeLengthDistribution
 //-------------------------------------------------
 
-void info::database_builder::string_table::dumpPrimaryBucketDistribution() const noexcept
+void info::database_builder::string_table::dumpProbeLengthDistribution() const noexcept
 {
-	int singularBucketCount = 0;
-	int multiBucketCount = 0;
-	int totalBucketCount = (int)m_primaryMapBuckets->size();
-
-	for (std::uint32_t bucket : *m_primaryMapBuckets)
+	// tally up how far each string is from where its hash would put it
+	std::size_t mask = m_slots.size() - 1;
+	std::map<std::size_t, int> probeLengthCounts;
+	for (std::size_t index = 0; index < m_slots.size(); index++)
 	{
-		if ((bucket & 0xC0000000) == 0xC0000000)
-			multiBucketCount++;
-		else if (bucket > 0)
-			singularBucketCount++;
-	}
-	int emptyBucketCount = totalBucketCount - singularBucketCount - multiBucketCount;
-
-	printf("\nPrimary bucket distribution:\n");
-	printf("%8d empty buckets    (%2d%%)\n", emptyBucketCount, emptyBucketCount * 100 / totalBucketCount);
-	printf("%8d singular buckets (%2d%%)\n", singularBucketCount, singularBucketCount * 100 / totalBucketCount);
-	printf("%8d multi buckets    (%2d%%)\n", multiBucketCount, multiBucketCount * 100 / totalBucketCount);
-	printf("%8d total buckets\n", totalBucketCount);
-}
-
-
-//-------------------------------------------------
-//  string_table::dumpSecondaryBucketDistribution
-//-------------------------------------------------
-
-void info::database_builder::string_table::dumpSecondaryBucketDistribution() const noexcept
-{
-	int total = 0;
-	std::map<int, int> bucketSizeCounts;
-
-	for (const SecondaryMapBucket &bucket : m_secondaryMapBuckets)
-	{
-		int bucketSize = (int)std::ranges::count_if(bucket, [](const auto &) { return true; });
-		auto iter = bucketSizeCounts.find(bucketSize);
-		if (iter == bucketSizeCounts.end())
-			iter = bucketSizeCounts.emplace(bucketSize, 0).first;
-		iter->second++;
-		total++;
+		if (m_slots[index].m_position != 0)
+		{
+			std::size_t probeLength = (index - m_slots[index].m_hash) & mask;
+			probeLengthCounts[probeLength]++;
+		}
 	}
 
-	printf("\nSecondary bucket size distribution (%d total):\n", (int)m_secondaryMapBuckets.size());
-	for (const auto &[size, count] : bucketSizeCounts)
-		printf("%5d: %7d (%3d%%)\n", size, count, count * 100 / total);
+	printf("\nHash table: %d of %d slots used (%2d%%)\n", (int)m_slotsUsed, (int)m_slots.size(), (int)(m_slotsUsed * 100 / m_slots.size()));
+	printf("Probe length distribution:\n");
+	for (const auto &[probeLength, count] : probeLengthCounts)
+		printf("%5d: %7d (%3d%%)\n", (int)probeLength, count, count * 100 / std::max(m_slotsUsed, 1u));
 }
@@ -16,7 +16,7 @@
 #include "xmlparser.h"
 
 // standard headers
-#include <forward_list>
+#include <vector>
 
 class QDataStream;
 
@@ -32,11 +32,16 @@ namespace info
 
 		// ctors
 		database_builder() = default;
+		database_builder(int shardCount);
 		database_builder(const database_builder &) = delete;
 		database_builder(database_builder &&) = default;
 
 		// methods
 		bool process_xml(QIODevice &stream, QString &error_message, const ProcessXmlCallback &progressCallback = { }) noexcept;
+		bool parse_xml(QIODevice &stream, QString &error_message, const ProcessXmlCallback &progressCallback = { }) noexcept;
+		void plan_capacity(const info::binaries::header &previous_header) noexcept;
+		void merge(const database_builder &shard) noexcept;
+		void finalize() noexcept;
 		void emit_info(QIODevice &stream) const noexcept;
 		void dump() const noexcept;
 
@@ -50,27 +55,36 @@ namespace info
 			string_table() noexcept;
 			void shrinkToFit() noexcept;
 			std::uint32_t get(const char8_t *string) noexcept;
-			std::uint32_t get(const std::u8string &string) noexcept;
+			std::uint32_t get(std::u8string_view string) noexcept;
 			std::uint32_t get(const XmlParser::Attribute &attribute) noexcept;
 			std::span<const char8_t> data() const noexcept;
 			const char8_t *lookup(std::uint32_t value, SsoBuffer &ssoBuffer) const noexcept;
 			template<typename T> void embed_value(T value) noexcept;
 			void dumpStringSizeDistribution() const noexcept;
-			void dumpPrimaryBucketDistribution() const noexcept;
-			void dumpSecondaryBucketDistribution() const noexcept;
+			void dumpProbeLengthDistribution() const noexcept;
 
 		private:
-			typedef std::forward_list<std::uint32_t> SecondaryMapBucket;
-
-			std::vector<char8_t>								m_data;
-			std::unique_ptr<std::array<std::uint32_t, 550007>>	m_primaryMapBuckets;
-			std::vector<SecondaryMapBucket>						m_secondaryMapBuckets;
-
-			std::uint32_t internalGet(std::span<const char8_t> string);
-			std::uint32_t &findBucket(std::u8string_view string);
+			// open addressing (linear probing) hash table slot
+			struct Slot
+			{
+				std::uint32_t	m_hash;			// low 32 bits of the string's hash
+				std::uint32_t	m_position;		// position of the string within m_data (zero if empty)
+			};
+
+			std::vector<char8_t>	m_data;
+			std::vector<Slot>		m_slots;
+			std::uint32_t			m_slotsUsed;
+
+			static std::uint32_t hash(std::u8string_view string) noexcept;
+			std::uint32_t internalGet(std::u8string_view string);
+			Slot &findSlot(std::u8string_view string);
+			void growSlots();
 		};
 
 		info::binaries::header									m_salted_header;
+		info::binaries::header									m_capacity_plan = defaultCapacityPlan();	// record counts to reserve
+		std::uint32_t											m_build_strindex = 0;
+		std::uint32_t											m_reallocation_count = 0;			// times the capacity plan fell short
 		std::vector<info::binaries::machine>					m_machines;
 		std::vector<info::binaries::biosset>					m_biossets;
 		std::vector<info::binaries::rom>						m_roms;
@@ -87,8 +101,29 @@ namespace info
 		std::vector<info::binaries::configuration_setting>		m_configuration_settings;
 		std::vector<info::binaries::software_list>				m_software_lists;
 		std::vector<info::binaries::ram_option>					m_ram_options;
+		std::vector<std::uint32_t>								m_machine_name_buckets;
+		std::vector<std::uint32_t>								m_machine_name_slots;
+		std::vector<info::binaries::machine_group>				m_machine_groups;
+		std::vector<info::binaries::machine_reference>			m_machine_references;
+		std::vector<info::binaries::rom_by_crc>					m_roms_by_crc;
+		std::vector<info::binaries::disk_by_sha1>				m_disks_by_sha1;
+		std::vector<std::uint32_t>								m_devices_by_tag;
+		std::vector<std::uint32_t>								m_chips_by_name;
+		std::vector<info::binaries::compressed_block>			m_compressed_blocks;
+		std::vector<std::uint8_t>								m_compressed_data;
 		string_table											m_strings;
-
+		std::size_t												m_compressionThreshold = 0x40000;	// smaller cold tables are stored raw
+		int														m_shardCount = 1;					// scales reservations when sharding
+
+		static info::binaries::header defaultCapacityPlan() noexcept;
+		void buildMachineNameIndex();
+		void buildMachineChildren();
+		void buildMachineGroups(info::binaries::header &header);
+		void buildHashIndexes();
+		void buildLookupIndexes();
+		template<typename TFunc> void buildSortedIndex(std::vector<std::uint32_t> &sorted, std::uint32_t index, std::uint32_t count, TFunc strindexFunc);
+		std::uint32_t emitMachineGroups(std::vector<std::pair<std::uint32_t, std::uint32_t>> &&keyedMachines);
+		template<typename T> void compressColdTable(const std::vector<T> &table);
 		void dumpTableSizes() const noexcept;
 	};
 }
@@ -9,6 +9,7 @@
 // bletchmame headers
 #include "listxmltask.h"
 #include "perfprofiler.h"
+#include "pipedevice.h"
 #include "xmlparser.h"
 #include "utility.h"
 #include "info.h"
@@ -17,10 +18,26 @@
 // Qt headers
 #include <QCoreApplication>
 #include <QDir>
+#include <QFile>
+#include <QProcess>
+#include <QSaveFile>
 
 // standard headers
+#include <algorithm>
+#include <cstring>
 #include <unordered_map>
 #include <exception>
+#include <mutex>
+#include <numeric>
+#include <thread>
+
+
+//**************************************************************************
+//  CONSTANTS
+//**************************************************************************
+
+// when sharding, machines are divvied up by the first character of their name
+static const char s_shardPrefixes[] = "0123456789abcdefghijklmnopqrstuvwxyz";
 
 
 //**************************************************************************
@@ -35,8 +52,9 @@ QEvent::Type ListXmlResultEvent::s_eventId = (QEvent::Type) QEvent::registerEven
 //  ctor
 //-------------------------------------------------
 
-ListXmlTask::ListXmlTask(QString &&outputFilename)
+ListXmlTask::ListXmlTask(QString &&outputFilename, int shardCount)
 	: m_outputFilename(std::move(outputFilename))
+	, m_shardCount(std::clamp(shardCount, 1, (int)strlen(s_shardPrefixes)))
 {
 }
 
@@ -47,7 +65,46 @@ ListXmlTask::ListXmlTask(QString &&outputFilename)
 
 QStringList ListXmlTask::getArguments(const Preferences &) const
 {
-	return { "-listxml" };
+	// the main process handles the first shard (or everything, if we're not sharding)
+	return QStringList({ "-listxml" }) << shardPatterns(0, m_shardCount);
+}
+
+
+//-------------------------------------------------
+//  shardPatterns - returns the -listxml patterns
+//	for a particular shard
+//-------------------------------------------------
+
+QStringList ListXmlTask::shardPatterns(int shard, int shardCount)
+{
+	QStringList result;
+	if (shardCount > 1)
+	{
+		for (int i = shard; i < (int)strlen(s_shardPrefixes); i += shardCount)
+			result << QString("%1*").arg(QChar(s_shardPrefixes[i]));
+	}
+	return result;
+}
+
+
+//-------------------------------------------------
+//  startShardProcesses - starts the MAME processes
+//	for all shards other than the first
+//-------------------------------------------------
+
+bool ListXmlTask::startShardProcesses(std::vector<QProcess *> &shardProcesses)
+{
+	for (int shard = 1; shard < m_shardCount; shard++)
+	{
+		QStringList arguments = { "-listxml" };
+		arguments << shardPatterns(shard, m_shardCount);
+
+		QProcess *process = startAdditionalEmuProcess(std::move(arguments));
+		if (!process)
+			return false;
+		shardProcesses.push_back(process);
+	}
+	return true;
 }
 
 
@@ -70,10 +127,13 @@ void ListXmlTask::run(std::optional<QProcess> &process)
 
 	ListXmlResultEvent::Status status;
 	QString errorMessage;
-	if (process)
+	std::vector<QProcess *> shardProcesses;
+	if (process && startShardProcesses(shardProcesses))
 	{
 		// process
-		std::optional<ListXmlError> result = internalRun(*process, progressCallback);
+		std::vector<QIODevice *> processes = { &*process };
+		processes.insert(processes.end(), shardProcesses.begin(), shardProcesses.end());
+		std::optional<ListXmlError> result = internalRun(processes, progressCallback);
 		if (result)
 		{
 			// an exception has occurred
@@ -104,11 +164,90 @@ void ListXmlTask::run(std::optional<QProcess> &process)
 
 std::optional<ListXmlTask::ListXmlError> ListXmlTask::internalRun(QIODevice &process, const info::database_builder::ProcessXmlCallback &progressCallback)
 {
-	info::database_builder builder;
+	QIODevice *processes[] = { &process };
+	return internalRun(processes, progressCallback);
+}
+
+
+//-------------------------------------------------
+//  internalRun
+//-------------------------------------------------
+
+std::optional<ListXmlTask::ListXmlError> ListXmlTask::internalRun(std::span<QIODevice * const> processes, const info::database_builder::ProcessXmlCallback &progressCallback)
+{
+	struct Shard
+	{
+		Shard(int shardCount) : m_builder(shardCount) { }
+
+		info::database_builder	m_builder;
+		PipeDevice				m_pipe;
+		std::thread				m_parseThread;
+		QString					m_errorMessage;
+		bool					m_success = false;
+		bool					m_empty = false;
+		int						m_machineCount = 0;
+	};
 
-	// first process the XML
-	QString error_message;
-	bool success = builder.process_xml(process, error_message, progressCallback);
+	// if there is a previous info DB, its header tells us how big the tables are likely to be
+	std::optional<info::binaries::header> previousHeader;
+	QFile previousFile(m_outputFilename);
+	if (previousFile.open(QIODevice::ReadOnly))
+		previousHeader = info::database::read_header(previousFile);
+	previousFile.close();
+
+	// first process the XML; this is pipelined - we drain MAME's output on this thread (which
+	// owns the processes) while worker threads parse each shard into its own builder
+	std::vector<std::unique_ptr<Shard>> shards;
+	for (std::size_t i = 0; i < processes.size(); i++)
+	{
+		Shard &shard = *shards.emplace_back(std::make_unique<Shard>((int)processes.size()));
+		if (previousHeader)
+			shard.m_builder.plan_capacity(*previousHeader);
+		if (!shard.m_pipe.open(QIODevice::ReadOnly | QIODevice::Unbuffered))
+			return ListXmlError(ListXmlResultEvent::Status::ERROR, "Could not open pipe");
+	}
+	std::mutex progressMutex;
+	for (std::unique_ptr<Shard> &shardPtr : shards)
+	{
+		// progress is reported as the total across all shards
+		Shard &shard = *shardPtr;
+		info::database_builder::ProcessXmlCallback shardProgressCallback;
+		if (progressCallback)
+		{
+			shardProgressCallback = [&shards, &shard, &progressMutex, &progressCallback](int machineCount, std::u8string_view machineName, std::u8string_view machineDescription)
+			{
+				std::unique_lock<std::mutex> lock(progressMutex);
+				shard.m_machineCount = machineCount;
+				int totalMachineCount = 0;
+				for (const std::unique_ptr<Shard> &s : shards)
+					totalMachineCount += s->m_machineCount;
+				progressCallback(totalMachineCount, machineName, machineDescription);
+			};
+		}
+
+		shard.m_parseThread = std::thread([&shard, isSharded = shards.size() > 1, shardProgressCallback = std::move(shardProgressCallback)]
+		{
+			// MAME emits nothing at all for a shard without any matching machines
+			shard.m_empty = isSharded && !shard.m_pipe.waitForReadyRead(-1);
+			shard.m_success = shard.m_empty || shard.m_builder.parse_xml(shard.m_pipe, shard.m_errorMessage, shardProgressCallback);
+
+			// if parsing stopped early, there is no point in draining any more
+			shard.m_pipe.cancel();
+		});
+	}
+
+	// pump all of the processes; when sharding we cannot block on any single one
+	std::vector<std::size_t> activeShards(shards.size());
+	std::iota(activeShards.begin(), activeShards.end(), 0);
+	while (!activeShards.empty())
+	{
+		std::erase_if(activeShards, [&shards, &processes](std::size_t i)
+		{
+			return !shards[i]->m_pipe.pumpStep(*processes[i], processes.size() > 1 ? 10 : -1);
+		});
+	}
+	for (std::unique_ptr<Shard> &shard : shards)
+		shard->m_parseThread.join();
 
 	// before we check to see if there is a parsing error, check for an abort - under which
 	// scenario a parsing error is expected
@@ -116,8 +255,19 @@ std::optional<ListXmlTask::ListXmlError> ListXmlTask::internalRun(QIODevice &pro
 		return ListXmlError(ListXmlResultEvent::Status::ABORTED);
 
 	// now check for a parse error (which should be very unlikely)
-	if (!success)
-		return ListXmlError(ListXmlResultEvent::Status::ERROR, QString("Error parsing XML from MAME -listxml: %1").arg(error_message));
+	for (const std::unique_ptr<Shard> &shard : shards)
+	{
+		if (!shard->m_success)
+			return ListXmlError(ListXmlResultEvent::Status::ERROR, QString("Error parsing XML from MAME -listxml: %1").arg(shard->m_errorMessage));
+	}
+	if (std::ranges::all_of(shards, [](const std::unique_ptr<Shard> &shard) { return shard->m_empty; }))
+		return ListXmlError(ListXmlResultEvent::Status::ERROR, "MAME -listxml did not return any output");
+
+	// merge all of the shards into the first one, and build everything else
+	info::database_builder &builder = shards[0]->m_builder;
+	for (std::size_t i = 1; i < shards.size(); i++)
+		builder.merge(shards[i]->m_builder);
+	builder.finalize();
 
 	// try creating the directory if its not present
 	QDir dir = QFileInfo(m_outputFilename).dir();
@@ -125,13 +275,16 @@ std::optional<ListXmlTask::ListXmlError> ListXmlTask::internalRun(QIODevice &pro
 		QDir().mkpath(dir.absolutePath());
 
 	// we finally have all of the info accumulated; now we can get to business with writing
-	// to the actual file
-	QFile file(m_outputFilename);
+	// to the actual file - we use QSaveFile so that the file is replaced atomically (the host
+	// releases its mapping of the previous Info DB before starting us)
+	QSaveFile file(m_outputFilename);
 	if (!file.open(QIODevice::WriteOnly))
 		return ListXmlError(ListXmlResultEvent::Status::ERROR, QString("Could not open file: %1").arg(m_outputFilename));
 
-	// emit the data and return
+	// emit the data
 	builder.emit_info(file);
+	if (!file.commit())
+		return ListXmlError(ListXmlResultEvent::Status::ERROR, QString("Could not write file: %1").arg(m_outputFilename));
 	return { };
 }
 
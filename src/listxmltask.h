@@ -18,6 +18,9 @@
 // Qt headers
 #include <QEvent>
 
+// standard headers
+#include <span>
+
 
 //**************************************************************************
 //  MACROS
@@ -94,7 +97,7 @@ public:
 	class Test;
 
 	// ctor
-	ListXmlTask(QString &&outputFilename);
+	ListXmlTask(QString &&outputFilename, int shardCount = 1);
 
 protected:
 	virtual QStringList getArguments(const Preferences &) const override final;
@@ -117,8 +120,12 @@ private:
 	};
 
 	QString			m_outputFilename;
+	int				m_shardCount;
 
+	static QStringList shardPatterns(int shard, int shardCount);
+	bool startShardProcesses(std::vector<QProcess *> &shardProcesses);
 	std::optional<ListXmlError> internalRun(QIODevice &process, const info::database_builder::ProcessXmlCallback &progressCallback = { });
+	std::optional<ListXmlError> internalRun(std::span<QIODevice * const> processes, const info::database_builder::ProcessXmlCallback &progressCallback = { });
 };
 
 #endif // LISTXMLTASK_H
@@ -165,21 +165,6 @@ void MachineFolderTreeModel::refresh()
 }
 
 
-//-------------------------------------------------
-//  getBiosMachine
-//-------------------------------------------------
-
-static std::optional<info::machine> getBiosMachine(info::machine machine)
-{
-	std::optional<info::machine> cloneOf;
-	while (bool(cloneOf = machine.clone_of()))
-		machine = *cloneOf;
-
-	std::optional<info::machine> romOf = machine.rom_of();
-	return romOf && romOf->is_bios() ? romOf : std::nullopt;
-}
-
-
 //-------------------------------------------------
 //  containsDisplayType
 //-------------------------------------------------
@@ -209,7 +194,7 @@ void MachineFolderTreeModel::populateVariableFolders()
 			if (!strcmp(desc.id(), "all"))
 				m_root.emplace_back(desc.id(), FolderIcon::Folder, desc.displayName(), [](const info::machine &machine) { return true; });
 			else if (!strcmp(desc.id(), "available"))
-				m_root.emplace_back(desc.id(), FolderIcon::FolderAvailable, desc.displayName(), [this](const info::machine &machine) { return m_prefs.getMachineAuditStatus(machine.name()) == AuditStatus::Found; });
+				m_root.emplace_back(desc.id(), FolderIcon::FolderAvailable, desc.displayName(), [this](const info::machine &machine) { AuditStatus status = m_prefs.getMachineAuditStatus(machine.name()); return status == AuditStatus::Found || status == AuditStatus::FoundMetadataOnly; });
 			else if (!strcmp(desc.id(), "bios"))
 				m_root.emplace_back(desc.id(), FolderIcon::Folder, desc.displayName(), m_bios);
 			else if (!strcmp(desc.id(), "chd"))
@@ -249,72 +234,31 @@ void MachineFolderTreeModel::populateVariableFolders()
 		}
 	}
 
-	// sort function for machines
-	auto compareMachineDesc = [](const info::machine &lhs, const info::machine &rhs)
+	// set up the BIOSes folder; these are sorted by description
+	std::vector<std::pair<info::machine_group, info::machine>> bioses;
+	bioses.reserve(m_infoDb.bios_groups().size());
+	for (info::machine_group group : m_infoDb.bios_groups())
 	{
-		return lhs.description() < rhs.description();
-	};
-
-	// iterate through all machines and accumulate the pertinent data; because
-	// this can be expensive we're using reference wrappers
-	std::set<info::machine, decltype(compareMachineDesc)> bioses;
-	std::set<std::reference_wrapper<const QString>> cpus;
-	std::set<std::reference_wrapper<const QString>> manufacturers;
-	std::set<std::reference_wrapper<const QString>> sounds;
-	std::set<std::reference_wrapper<const QString>> sourceFiles;
-	std::set<std::reference_wrapper<const QString>> years;
-	for (info::machine machine : m_infoDb.machines())
-	{
-		if (machine.runnable())
-		{
-			// manufacturer/source/year folders
-			manufacturers.emplace(machine.manufacturer());
-			sourceFiles.emplace(machine.sourcefile());
-			years.emplace(machine.year());
-
-			// cpu/sound folders
-			for (info::chip chip : machine.chips())
-			{
-				switch (chip.type())
-				{
-				case info::chip::type_t::CPU:
-					cpus.emplace(chip.name());
-					break;
-
-				case info::chip::type_t::AUDIO:
-					sounds.emplace(chip.name());
-					break;
-
-				default:
-					// ignore anything we don't know about
-					break;
-				}
-			}
-
-			// bios folder
-			std::optional<info::machine> biosMachine = getBiosMachine(machine);
-			if (biosMachine)
-				bioses.emplace(*biosMachine);
-		}
+		std::optional<info::machine> bios = m_infoDb.find_machine(group.name());
+		if (bios)
+			bioses.emplace_back(group, *bios);
 	}
-
-	// set up the BIOSes folder
+	std::ranges::stable_sort(bioses, [](const auto &lhs, const auto &rhs)
+	{
+		return lhs.second.description() < rhs.second.description();
+	});
 	m_bios.clear();
 	m_bios.reserve(bioses.size());
-	for (const info::machine &bios : bioses)
+	for (const auto &pair : bioses)
 	{
-		auto predicate = [bios](const info::machine &machine) { return getBiosMachine(machine) == bios; };
+		const info::machine_group &group = pair.first;
+		const info::machine &bios = pair.second;
+		auto predicate = [group](const info::machine &machine) { return group.contains(machine); };
 		m_bios.emplace_back(bios.name(), FolderIcon::Folder, bios.description(), std::move(predicate));
 	}
 
 	// set up the CPUs folder
-	m_cpu.clear();
-	m_cpu.reserve(cpus.size());
-	for (const QString &cpu : cpus)
-	{
-		auto predicate = [&cpu](const info::machine &machine) { return (bool) machine.find_chip(cpu); };
-		m_cpu.emplace_back(cpu, FolderIcon::Cpu, cpu, std::move(predicate));
-	}
+	populateGroupFolders(m_cpu, m_infoDb.cpu_groups(), FolderIcon::Cpu);
 
 	// set up the custom folder
 	const auto &customFolders = m_prefs.getCustomFolders();
@@ -328,40 +272,27 @@ void MachineFolderTreeModel::populateVariableFolders()
 		m_custom.emplace_back(folderName, FolderIcon::Folder, folderName, std::move(predicate));
 	}	
 
-	// set up the manufacturers folder
-	m_manufacturer.clear();
-	m_manufacturer.reserve(manufacturers.size());
-	for (const QString &manufacturer : manufacturers)
-	{
-		auto predicate = [&manufacturer](const info::machine &machine) { return machine.manufacturer() == manufacturer; };
-		m_manufacturer.emplace_back(manufacturer, FolderIcon::Manufacturer, manufacturer, std::move(predicate));
-	}
+	// set up the manufacturers, sound, sources and years folders
+	populateGroupFolders(m_manufacturer, m_infoDb.manufacturer_groups(), FolderIcon::Manufacturer);
+	populateGroupFolders(m_sound, m_infoDb.sound_groups(), FolderIcon::Sound);
+	populateGroupFolders(m_source, m_infoDb.sourcefile_groups(), FolderIcon::Source);
+	populateGroupFolders(m_year, m_infoDb.year_groups(), FolderIcon::Year);
+}
 
-	// set up the CPUs folder
-	m_sound.clear();
-	m_sound.reserve(sounds.size());
-	for (const QString &sound : sounds)
-	{
-		auto predicate = [&sound](const info::machine &machine) { return (bool) machine.find_chip(sound); };
-		m_sound.emplace_back(sound, FolderIcon::Sound, sound, std::move(predicate));
-	}
 
-	// set up the sources folder
-	m_source.clear();
-	m_source.reserve(sourceFiles.size());
-	for (const QString &sourceFile : sourceFiles)
-	{
-		auto predicate = [&sourceFile](const info::machine &machine) { return machine.sourcefile() == sourceFile; };
-		m_source.emplace_back(sourceFile, FolderIcon::Source, sourceFile, std::move(predicate));
-	}
+//-------------------------------------------------
+//  populateGroupFolders - populates folders from
+//	the Info DB's machine groups
+//-------------------------------------------------
 
-	// set up the years folder
-	m_year.clear();
-	m_year.reserve(years.size());
-	for (const QString &year : years)
+void MachineFolderTreeModel::populateGroupFolders(std::vector<FolderEntry> &folders, const info::machine_group::view &groups, FolderIcon icon)
+{
+	folders.clear();
+	folders.reserve(groups.size());
+	for (info::machine_group group : groups)
 	{
-		auto predicate = [&year](const info::machine &machine) { return machine.year() == year; };
-		m_year.emplace_back(year, FolderIcon::Year, year, std::move(predicate));
+		auto predicate = [group](const info::machine &machine) { return group.contains(machine); };
+		folders.emplace_back(group.name(), icon, group.name(), std::move(predicate));
 	}
 }
 
@@ -130,6 +130,7 @@ private:
 	static const FolderEntry &folderEntryFromModelIndex(const QModelIndex &index);
 	const std::vector<FolderEntry> &childFolderEntriesFromModelIndex(const QModelIndex &parent) const;
 	void populateVariableFolders();
+	void populateGroupFolders(std::vector<FolderEntry> &folders, const info::machine_group::view &groups, FolderIcon icon);
 };
 
 
@@ -912,12 +912,14 @@ void MainPanel::updateStatusFromSelection()
 QString MainPanel::machineStatusString(const info::machine &machine) const
 {
 	QString result;
-	switch (m_prefs.getMachineAuditStatus(machine.name()))
+	AuditStatus auditStatus = m_prefs.getMachineAuditStatus(machine.name());
+	switch (auditStatus)
 	{
 	case AuditStatus::Unknown:
 		result = "Unknown";
 		break;
 	case AuditStatus::Found:
+	case AuditStatus::FoundMetadataOnly:
 		switch (machine.quality_status())
 		{
 		case info::machine::driver_quality_t::UNKNOWN:
@@ -932,6 +934,8 @@ QString MainPanel::machineStatusString(const info::machine &machine) const
 			result = "Preliminary";
 			break;
 		}
+		if (auditStatus == AuditStatus::FoundMetadataOnly)
+			result += " (Verified By Metadata Only)";
 		break;
 	case AuditStatus::MissingOptional:
 		result = "Optional Media Missing";
@@ -1084,7 +1088,7 @@ void MainPanel::iterateItemModelIndexes(QAbstractItemModel &model, const std::fu
 void MainPanel::manualAudit(const info::machine &machine)
 {
 	// set up the audit task
-	AuditTask::ptr auditTask = std::make_shared<AuditTask>(true, -1);
+	AuditTask::ptr auditTask = std::make_shared<AuditTask>(true, -1, m_host.getHashCache());
 	const Audit &audit = auditTask->addMachineAudit(m_prefs, machine);
 
 	// get the icon for this machine
@@ -1102,7 +1106,7 @@ void MainPanel::manualAudit(const info::machine &machine)
 void MainPanel::manualAudit(const software_list::software &software)
 {
 	// set up the audit task
-	AuditTask::ptr auditTask = std::make_shared<AuditTask>(true, -1);
+	AuditTask::ptr auditTask = std::make_shared<AuditTask>(true, -1, m_host.getHashCache());
 	const Audit &audit = auditTask->addSoftwareAudit(m_prefs, software);
 
 	// and run the dialog
@@ -53,6 +53,7 @@ public:
 	virtual void auditIfAppropriate(const software_list::software &software) = 0;
 	virtual void auditDialogStarted(AuditDialog &auditDialog, std::shared_ptr<AuditTask> &&auditTask) = 0;
 	virtual software_list_collection &getAuditSoftwareListCollection() = 0;
+	virtual HashCache::ptr getHashCache() = 0;
 	virtual void updateAuditTimer() = 0;
 };
 
@@ -596,7 +596,8 @@ MainWindow::MainWindow(QWidget *parent)
 	, m_mainPanel(nullptr)
 	, m_prefs(QDir(QStandardPaths::writableLocation(QStandardPaths::AppDataLocation)))
 	, m_taskDispatcher(*this, m_prefs)
-	, m_auditQueue(m_prefs, m_info_db, m_auditSoftwareListCollection, 20)
+	, m_hashCache(std::make_shared<HashCache>(m_prefs.getHashCachePath()))
+	, m_auditQueue(m_prefs, m_info_db, m_auditSoftwareListCollection, 20, m_hashCache)
 	, m_auditTimer(nullptr)
 	, m_maximumConcurrentAuditTasks(std::thread::hardware_concurrency() * 3 + 8)
 	, m_auditCursor(m_prefs)
@@ -1146,6 +1147,7 @@ void MainWindow::on_menuAuditing_aboutToShow()
 	m_ui->actionAuditingDisabled->setChecked(auditingState == Preferences::AuditingState::Disabled);
 	m_ui->actionAuditingAutomatic->setChecked(auditingState == Preferences::AuditingState::Automatic);
 	m_ui->actionAuditingManual->setChecked(auditingState == Preferences::AuditingState::Manual);
+	m_ui->actionAuditingQuick->setChecked(m_prefs.getQuickAuditing());
 
 	// identify the currently selected auditable
 	std::optional<info::machine> selectedMachine;
@@ -1207,6 +1209,16 @@ void MainWindow::on_actionAuditingManual_triggered()
 }
 
 
+//-------------------------------------------------
+//  on_actionAuditingQuick_triggered
+//-------------------------------------------------
+
+void MainWindow::on_actionAuditingQuick_triggered()
+{
+	m_prefs.setQuickAuditing(!m_prefs.getQuickAuditing());
+}
+
+
 //-------------------------------------------------
 //  on_actionAuditThis_triggered
 //-------------------------------------------------
@@ -1660,9 +1672,19 @@ bool MainWindow::refreshMameInfoDatabase()
 	if (!IsMameExecutablePresent())
 		return false;
 
-	// list XML
+	// the current info DB is memory mapped, and the new one will be renamed over it (which
+	// fails on Windows while the mapping is live) so release it for the duration; it gets
+	// reloaded when the task completes, regardless of how it completes
+	if (!m_state)
+		m_info_db.reset();
+
+	// list XML; this can be sharded across multiple MAME processes, but each one has the full
+	// memory footprint of MAME so unless the user asked for a specific count we only use a few
+	int processCount = m_prefs.getListXmlProcessCount();
+	if (processCount <= 0)
+		processCount = std::min(QThread::idealThreadCount(), 4);
 	QString dbPath = m_prefs.getMameXmlDatabasePath();
-	Task::ptr task = std::make_shared<ListXmlTask>(std::move(dbPath));
+	Task::ptr task = std::make_shared<ListXmlTask>(std::move(dbPath), processCount);
 	m_taskDispatcher.launch(task);
 
 	// callback to request interruptions when an emulation is running
@@ -2247,12 +2269,14 @@ bool MainWindow::onListXmlCompleted(const ListXmlResultEvent &event)
 		break;
 
 	case ListXmlResultEvent::Status::ABORTED:
-		// if we aborted, do nothing
+		// if we aborted, restore the previous DB
+		loadInfoDb();
 		dialogResult = QDialog::Rejected;
 		break;
 
 	case ListXmlResultEvent::Status::ERROR:
-		// present an error message
+		// restore the previous DB and present an error message
+		loadInfoDb();
 		messageBox(!event.errorMessage().isEmpty()
 			? event.errorMessage()
 			: "Error building MAME info database");
@@ -2941,6 +2965,16 @@ software_list_collection &MainWindow::getAuditSoftwareListCollection()
 }
 
 
+//-------------------------------------------------
+//  getHashCache
+//-------------------------------------------------
+
+HashCache::ptr MainWindow::getHashCache()
+{
+	return m_hashCache;
+}
+
+
 //-------------------------------------------------
 //  auditTimerProc
 //-------------------------------------------------
@@ -3072,6 +3106,9 @@ QString MainWindow::auditStatusString(AuditStatus status)
 	case AuditStatus::Found:
 		result = "All Media Found";
 		break;
+	case AuditStatus::FoundMetadataOnly:
+		result = "All Media Found (Verified By Metadata Only)";
+		break;
 	case AuditStatus::MissingOptional:
 		result = "Optional Media Missing";
 		break;
@@ -86,6 +86,7 @@ private slots:
 	void on_actionAuditingDisabled_triggered();
 	void on_actionAuditingAutomatic_triggered();
 	void on_actionAuditingManual_triggered();
+	void on_actionAuditingQuick_triggered();
 	void on_actionAuditThis_triggered();
 	void on_actionResetAuditingStatuses_triggered();	
 	void on_actionDebugger_triggered();
@@ -175,6 +176,7 @@ private:
 	std::optional<status::state>		m_state;
 
 	// auditing
+	HashCache::ptr						m_hashCache;
 	AuditQueue							m_auditQueue;
 	software_list_collection			m_auditSoftwareListCollection;
 	QTimer *							m_auditTimer;
@@ -271,6 +273,7 @@ private:
 	virtual void updateAuditTimer() override final;
 	virtual void auditDialogStarted(AuditDialog &auditDialog, std::shared_ptr<AuditTask> &&auditTask) override final;
 	virtual software_list_collection &getAuditSoftwareListCollection() override final;
+	virtual HashCache::ptr getHashCache() override final;
 	void auditTimerProc();
 	void dispatchAuditTasks();
 	void reportAuditResults(const std::vector<AuditResult> &results);
@@ -63,6 +63,15 @@ MameTask::MameTask()
 }
 
 
+//-------------------------------------------------
+//  dtor
+//-------------------------------------------------
+
+MameTask::~MameTask()
+{
+}
+
+
 //-------------------------------------------------
 //  prepare
 //-------------------------------------------------
@@ -78,8 +87,8 @@ void MameTask::prepare(Preferences &prefs, EventHandlerFunc &&eventHandler)
 	m_arguments = getArguments(prefs);
 
 	// slap on any extra arguments
-	const QString &extraArguments = prefs.getMameExtraArguments();
-	appendExtraArguments(m_arguments, extraArguments);
+	m_extraArguments = prefs.getMameExtraArguments();
+	appendExtraArguments(m_arguments, m_extraArguments);
 
 	// log the command line (if appropriate)
 	if (LOG_LAUNCH_COMMAND)
@@ -213,6 +222,42 @@ void MameTask::run()
 
 	// use our own run call
 	run(emuProcess);
+
+	// and clean up any additional processes (outside of the lock, because this waits for them)
+	std::vector<std::unique_ptr<QProcess>> additionalProcesses;
+	{
+		QMutexLocker locker(&m_activeProcessMutex);
+		additionalProcesses = std::move(m_additionalProcesses);
+	}
+	additionalProcesses.clear();
+}
+
+
+//-------------------------------------------------
+//  startAdditionalEmuProcess
+//-------------------------------------------------
+
+QProcess *MameTask::startAdditionalEmuProcess(QStringList &&arguments)
+{
+	// these get the same extra arguments as the main process
+	appendExtraArguments(arguments, m_extraArguments);
+
+	// create the process alongside the active one, so that it can be killed
+	QProcess *process;
+	{
+		QMutexLocker locker(&m_activeProcessMutex);
+		process = m_additionalProcesses.emplace_back(std::make_unique<QProcess>()).get();
+	}
+
+	// start the process
+	process->setReadChannel(QProcess::StandardOutput);
+	process->start(m_program, arguments);
+	if (!process->waitForStarted(-1))
+		return nullptr;
+
+	// and add it to the job, so it does not outlive us
+	s_job.addProcess(process->processId());
+	return process;
 }
 
 
@@ -225,4 +270,6 @@ void MameTask::killActiveEmuProcess()
 	QMutexLocker locker(&m_activeProcessMutex);
 	if (m_activeProcess)
 		m_activeProcess->kill();
+	for (const std::unique_ptr<QProcess> &process : m_additionalProcesses)
+		process->kill();
 }
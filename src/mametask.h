@@ -18,6 +18,10 @@
 // Qt headers
 #include <QMutex>
 
+// standard headers
+#include <memory>
+#include <vector>
+
 
 //**************************************************************************
 //  TYPE DEFINITIONS
@@ -55,8 +59,9 @@ public:
 	};
 
 protected:
-	// ctor
+	// ctor/dtor
 	MameTask();
+	~MameTask();
 
 	// if there is an active 
 	void killActiveEmuProcess();
@@ -73,6 +78,10 @@ protected:
 	// called on a child thread tasked with ownership of a MAME child process
 	virtual void run(std::optional<QProcess> &process) = 0;
 
+	// starts an additional MAME child process, for tasks that need more than one; we own
+	// these (so that killActiveEmuProcess() can get to them) until the task completes
+	QProcess *startAdditionalEmuProcess(QStringList &&arguments);
+
 	// accesses the exit code
 	const std::optional<EmuExitCode> &emuExitCode() const { return m_emuExitCode; }
 
@@ -82,7 +91,9 @@ private:
 	static Job					s_job;
 	QString						m_program;
 	QStringList					m_arguments;
+	QString						m_extraArguments;
 	QProcess *					m_activeProcess;
+	std::vector<std::unique_ptr<QProcess>>	m_additionalProcesses;
 	QMutex						m_activeProcessMutex;
 	std::optional<EmuExitCode>	m_emuExitCode;
 
@@ -0,0 +1,220 @@
+/***************************************************************************
+
+	pipedevice.cpp
+
+	QIODevice that hands buffers from a producer thread to a consumer
+	thread (used to overlap reading MAME's output with parsing it)
+
+***************************************************************************/
+
+// bletchmame headers
+#include "pipedevice.h"
+
+// Qt headers
+#include <QProcess>
+
+// standard headers
+#include <chrono>
+
+
+//**************************************************************************
+//  IMPLEMENTATION
+//**************************************************************************
+
+//-------------------------------------------------
+//  ctor
+//-------------------------------------------------
+
+PipeDevice::PipeDevice(std::size_t maximumBufferCount)
+	: m_maximumBufferCount(maximumBufferCount)
+	, m_frontBufferPosition(0)
+	, m_finished(false)
+	, m_cancelled(false)
+{
+}
+
+
+//-------------------------------------------------
+//  pushBuffer
+//-------------------------------------------------
+
+bool PipeDevice::pushBuffer(QByteArray &&buffer)
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+
+	// wait for room
+	m_condition.wait(lock, [this] { return m_buffers.size() < m_maximumBufferCount || m_cancelled; });
+	if (m_cancelled)
+		return false;
+
+	// and push the buffer (empty buffers would be indistinguishable from the end of input)
+	if (!buffer.isEmpty())
+	{
+		m_buffers.push_back(std::move(buffer));
+		m_condition.notify_all();
+	}
+	return true;
+}
+
+
+//-------------------------------------------------
+//  pumpStep - moves whatever another device has
+//	available (waiting up to msecs for it) into
+//	this pipe; returns false (and marks the pipe
+//	finished) when there is nothing more to pump
+//-------------------------------------------------
+
+bool PipeDevice::pumpStep(QIODevice &source, int msecs, qint64 bufferSize)
+{
+	// this seems to be necessary when reading from a QProcess
+	if (source.bytesAvailable() <= 0)
+		source.waitForReadyRead(msecs);
+
+	// read what we can; like XmlParser, we treat a read that returns nothing as the end of input (unless
+	// we gave up waiting, in which case we need to check)
+	QByteArray buffer = source.read(bufferSize);
+	bool done = buffer.isEmpty()
+		? msecs < 0 || sourceAtEnd(source)
+		: !pushBuffer(std::move(buffer));
+
+	if (done)
+		finish();
+	return !done;
+}
+
+
+//-------------------------------------------------
+//  sourceAtEnd - a QProcess that has not written
+//	anything lately is at its "end" even though
+//	it may very well write more, so we need to
+//	wait for it to exit
+//-------------------------------------------------
+
+bool PipeDevice::sourceAtEnd(QIODevice &source)
+{
+	QProcess *process = qobject_cast<QProcess *>(&source);
+	return process
+		? process->state() == QProcess::NotRunning && process->bytesAvailable() <= 0
+		: source.atEnd();
+}
+
+
+//-------------------------------------------------
+//  pumpFrom - drains another device into this
+//	pipe, and then marks it finished
+//-------------------------------------------------
+
+void PipeDevice::pumpFrom(QIODevice &source, qint64 bufferSize)
+{
+	while (pumpStep(source, -1, bufferSize))
+		;
+}
+
+
+//-------------------------------------------------
+//  finish - signals the end of input
+//-------------------------------------------------
+
+void PipeDevice::finish()
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_finished = true;
+	m_condition.notify_all();
+}
+
+
+//-------------------------------------------------
+//  cancel - called by the consumer if it is no
+//	longer interested in input
+//-------------------------------------------------
+
+void PipeDevice::cancel()
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_cancelled = true;
+	m_buffers.clear();
+	m_frontBufferPosition = 0;
+	m_condition.notify_all();
+}
+
+
+//-------------------------------------------------
+//  isSequential
+//-------------------------------------------------
+
+bool PipeDevice::isSequential() const
+{
+	return true;
+}
+
+
+//-------------------------------------------------
+//  bytesAvailable
+//-------------------------------------------------
+
+qint64 PipeDevice::bytesAvailable() const
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	qint64 result = QIODevice::bytesAvailable() - m_frontBufferPosition;
+	for (const QByteArray &buffer : m_buffers)
+		result += buffer.size();
+	return result;
+}
+
+
+//-------------------------------------------------
+//  waitForReadyRead
+//-------------------------------------------------
+
+bool PipeDevice::waitForReadyRead(int msecs)
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	auto predicate = [this] { return !m_buffers.empty() || m_finished || m_cancelled; };
+	if (msecs < 0)
+		m_condition.wait(lock, predicate);
+	else
+		m_condition.wait_for(lock, std::chrono::milliseconds(msecs), predicate);
+	return !m_buffers.empty();
+}
+
+
+//-------------------------------------------------
+//  readData
+//-------------------------------------------------
+
+qint64 PipeDevice::readData(char *data, qint64 maxSize)
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+
+	// block until we have something (this device is only useful when the consumer has nothing
+	// better to do than wait for data)
+	m_condition.wait(lock, [this] { return !m_buffers.empty() || m_finished || m_cancelled; });
+	if (m_buffers.empty())
+		return -1;
+
+	// copy out of the front buffer
+	const QByteArray &frontBuffer = m_buffers.front();
+	qint64 size = std::min(maxSize, (qint64)(frontBuffer.size() - m_frontBufferPosition));
+	memcpy(data, frontBuffer.constData() + m_frontBufferPosition, size);
+	m_frontBufferPosition += size;
+
+	// and retire the front buffer if we're done with it
+	if (m_frontBufferPosition >= frontBuffer.size())
+	{
+		m_buffers.pop_front();
+		m_frontBufferPosition = 0;
+		m_condition.notify_all();
+	}
+	return size;
+}
+
+
+//-------------------------------------------------
+//  writeData
+//-------------------------------------------------
+
+qint64 PipeDevice::writeData(const char *, qint64)
+{
+	// use pushBuffer()
+	return -1;
+}
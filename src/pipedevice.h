@@ -0,0 +1,73 @@
+/***************************************************************************
+
+	pipedevice.h
+
+	QIODevice that hands buffers from a producer thread to a consumer
+	thread (used to overlap reading MAME's output with parsing it)
+
+***************************************************************************/
+
+#pragma once
+
+#ifndef PIPEDEVICE_H
+#define PIPEDEVICE_H
+
+// Qt headers
+#include <QByteArray>
+#include <QIODevice>
+
+// standard headers
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+
+//**************************************************************************
+//  TYPE DEFINITIONS
+//**************************************************************************
+
+// ======================> PipeDevice
+
+class PipeDevice : public QIODevice
+{
+public:
+	class Test;
+
+	// ctor
+	PipeDevice(std::size_t maximumBufferCount = 16);
+	PipeDevice(const PipeDevice &) = delete;
+	PipeDevice(PipeDevice &&) = delete;
+
+	// producer side; pushBuffer() blocks while the pipe is full, and returns false if the consumer cancelled
+	bool pushBuffer(QByteArray &&buffer);
+	bool pumpStep(QIODevice &source, int msecs, qint64 bufferSize = 1048576);
+	void pumpFrom(QIODevice &source, qint64 bufferSize = 1048576);
+	void finish();
+
+	// consumer side
+	void cancel();
+
+	// QIODevice overrides
+	virtual bool isSequential() const override;
+	virtual qint64 bytesAvailable() const override;
+	virtual bool waitForReadyRead(int msecs) override;
+
+protected:
+	// QIODevice overrides
+	virtual qint64 readData(char *data, qint64 maxSize) override;
+	virtual qint64 writeData(const char *data, qint64 maxSize) override;
+
+private:
+	mutable std::mutex			m_mutex;
+	std::condition_variable		m_condition;
+	std::deque<QByteArray>		m_buffers;
+	std::size_t					m_maximumBufferCount;
+	qsizetype					m_frontBufferPosition;
+	bool						m_finished;
+	bool						m_cancelled;
+
+	static bool sourceAtEnd(QIODevice &source);
+};
+
+
+#endif // PIPEDEVICE_H
@@ -73,6 +73,7 @@ static const util::enum_parser_bidirectional<AuditStatus> s_audit_status_parser
 {
 	{ "unknown", AuditStatus::Unknown, },
 	{ "found", AuditStatus::Found, },
+	{ "foundmetadataonly", AuditStatus::FoundMetadataOnly, },
 	{ "missing", AuditStatus::Missing },
 	{ "missingoptional", AuditStatus::MissingOptional }
 };
@@ -223,6 +224,7 @@ Preferences::Preferences(std::optional<QDir> &&configDirectory, QObject *parent)
 	: QObject(parent)
 	, m_configDirectory(std::move(configDirectory))
 	, m_globalPathsInfo(m_configDirectory)
+	, m_listXmlProcessCount(0)
 	, m_windowState(WindowState::Normal)
 	, m_selected_tab(list_view_type::MACHINE)
 {
@@ -345,6 +347,7 @@ void Preferences::setGlobalInfo(Preferences::GlobalUiInfo &&globalInfo)
 	// we have to copy each of the properties individually because these might fire signals
 	setWindowBarsShown(globalInfo.m_windowBarsShown);
 	setAuditingState(globalInfo.m_auditingState);
+	setQuickAuditing(globalInfo.m_quickAuditing);
 	setShowStopEmulationWarning(globalInfo.m_showStopEmulationWarning);
 }
 
@@ -769,7 +772,7 @@ AuditStatus Preferences::getMachineAuditStatus(const QString &machine_name) cons
 void Preferences::setMachineAuditStatus(const QString &machine_name, AuditStatus status)
 {
 	assert(status == AuditStatus::Unknown || status == AuditStatus::Found
-		|| status == AuditStatus::MissingOptional || status == AuditStatus::Missing);
+		|| status == AuditStatus::FoundMetadataOnly || status == AuditStatus::MissingOptional || status == AuditStatus::Missing);
 	m_machine_info[machine_name].m_auditStatus = status;
 }
 
@@ -939,10 +942,11 @@ bool Preferences::load(QIODevice &input)
 	xml.onElementBegin({ "preferences" }, [&](const XmlParser::Attributes &attributes)
 	{
 		// windowBarsShown is called menu_bar_shown in the XML for purely historical reasons
-		const auto [windowBarsShown, windowStateAttr, selectedTabAttr, auditing, showStopEmulationWarning] = attributes.get("menu_bar_shown", "window_state", "selected_tab", "auditing", "show_stop_emulation_warning");
+		const auto [windowBarsShown, windowStateAttr, selectedTabAttr, auditing, quickAuditing, showStopEmulationWarning] = attributes.get("menu_bar_shown", "window_state", "selected_tab", "auditing", "quick_auditing", "show_stop_emulation_warning");
 
 		globalUiInfo.m_windowBarsShown = windowBarsShown.as<bool>().value_or(globalUiInfo.m_windowBarsShown);
 		globalUiInfo.m_auditingState = auditing.as<AuditingState>(s_auditingStateParser).value_or(globalUiInfo.m_auditingState);
+		globalUiInfo.m_quickAuditing = quickAuditing.as<bool>().value_or(globalUiInfo.m_quickAuditing);
 		globalUiInfo.m_showStopEmulationWarning = showStopEmulationWarning.as<bool>().value_or(globalUiInfo.m_showStopEmulationWarning);
 
 		std::optional<WindowState> windowState = windowStateAttr.as<WindowState>(s_windowState_parser);
@@ -978,6 +982,13 @@ bool Preferences::load(QIODevice &input)
 	{
 		setMameExtraArguments(util::toQString(content));
 	});
+	xml.onElementEnd({ "preferences", "listxmlprocesses" }, [&](std::u8string &&content)
+	{
+		bool ok;
+		int processCount = util::toQString(content).toInt(&ok);
+		if (ok && processCount >= 0)
+			setListXmlProcessCount(processCount);
+	});
 	xml.onElementBegin({ "preferences", "size" }, [&](const XmlParser::Attributes &attributes)
 	{
 		const auto [widthAttr, heightAttr] = attributes.get("width", "height");
@@ -1175,6 +1186,7 @@ void Preferences::save(QIODevice &output)
 	writer.writeAttribute("window_state", s_windowState_parser[getWindowState()]);
 	writer.writeAttribute("selected_tab", s_list_view_type_parser[getSelectedTab()]);
 	writer.writeAttribute("auditing", s_auditingStateParser[getAuditingState()]);
+	writer.writeAttribute("quick_auditing", QString::number(getQuickAuditing() ? 1 : 0));
 	writer.writeAttribute("show_stop_emulation_warning", QString::number(getShowStopEmulationWarning() ? 1 : 0));
 
 	// paths
@@ -1190,6 +1202,8 @@ void Preferences::save(QIODevice &output)
 	writer.writeComment("Miscellaneous");
 	if (!m_mame_extra_arguments.isEmpty())
 		writer.writeTextElement("mameextraarguments", m_mame_extra_arguments);
+	if (m_listXmlProcessCount > 0)
+		writer.writeTextElement("listxmlprocesses", QString::number(m_listXmlProcessCount));
 	if (m_size)
 	{
 		writer.writeStartElement("size");
@@ -1446,6 +1460,34 @@ QString Preferences::getMameXmlDatabasePath(bool ensure_directory_exists) const
 }
 
 
+//-------------------------------------------------
+//  getHistoryCachePath
+//-------------------------------------------------
+
+QString Preferences::getHistoryCachePath() const
+{
+	// do we have a config directory?
+	if (!m_configDirectory)
+		return "";
+
+	return m_configDirectory->filePath("history.cache");
+}
+
+
+//-------------------------------------------------
+//  getHashCachePath
+//-------------------------------------------------
+
+QString Preferences::getHashCachePath() const
+{
+	// do we have a config directory?
+	if (!m_configDirectory)
+		return "";
+
+	return m_configDirectory->filePath("hashes.cache");
+}
+
+
 //-------------------------------------------------
 //  getPreferencesFileName
 //-------------------------------------------------
@@ -1475,6 +1517,7 @@ QString Preferences::getPreferencesFileName(bool ensureDirectoryExists) const
 Preferences::GlobalUiInfo::GlobalUiInfo()
 	: m_windowBarsShown(true)
 	, m_auditingState(AuditingState::Default)
+	, m_quickAuditing(false)
 	, m_showStopEmulationWarning(true)
 {
 }
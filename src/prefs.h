@@ -32,6 +32,7 @@ enum class AuditStatus
 {
 	Unknown,
 	Found,
+	FoundMetadataOnly,
 	MissingOptional,
 	Missing
 };
@@ -168,6 +169,9 @@ public:
 	const QString &getMameExtraArguments() const														{ return m_mame_extra_arguments; }
 	void setMameExtraArguments(QString &&extra_arguments)												{ m_mame_extra_arguments = std::move(extra_arguments); }
 
+	int getListXmlProcessCount() const																	{ return m_listXmlProcessCount; }
+	void setListXmlProcessCount(int processCount)														{ m_listXmlProcessCount = processCount; }
+
 	const std::optional<QSize> &getSize() const								 							{ return m_size; }
 	void setSize(const std::optional<QSize> &size)														{ m_size = size; }
 
@@ -210,6 +214,9 @@ public:
 	AuditingState getAuditingState() const																{ return m_globalUiInfo.m_auditingState; }
 	void setAuditingState(AuditingState auditingState);
 
+	bool getQuickAuditing() const																		{ return m_globalUiInfo.m_quickAuditing; }
+	void setQuickAuditing(bool quickAuditing)															{ m_globalUiInfo.m_quickAuditing = quickAuditing; }
+
 	bool getShowStopEmulationWarning() const															{ return m_globalUiInfo.m_showStopEmulationWarning;	}
 	void setShowStopEmulationWarning(bool show)															{ m_globalUiInfo.m_showStopEmulationWarning = show;	}
 
@@ -231,6 +238,8 @@ public:
 	void setMameIniImportActionPreference(global_path_type type, const std::optional<MameIniImportActionPreference> &importActionPreference);
 
 	QString getMameXmlDatabasePath(bool ensure_directory_exists = true) const;
+	QString getHistoryCachePath() const;
+	QString getHashCachePath() const;
 	QString applySubstitutions(const QString &path) const;
 	static QString internalApplySubstitutions(const QString &src, std::function<QString(const QString &)> func);
 
@@ -276,6 +285,7 @@ private:
 		// members
 		bool																					m_windowBarsShown;
 		AuditingState																			m_auditingState;
+		bool																					m_quickAuditing;
 		bool																					m_showStopEmulationWarning;
 	};
 
@@ -312,6 +322,7 @@ private:
 	GlobalUiInfo																				m_globalUiInfo;
 	GlobalPathsInfo																				m_globalPathsInfo;
 	QString                                                                 					m_mame_extra_arguments;
+	int																							m_listXmlProcessCount;		// zero is automatic
 	std::optional<QSize>																		m_size;
 	WindowState																					m_windowState;
 	mutable std::unordered_map<std::u8string, std::unordered_map<std::u8string, ColumnPrefs>>	m_column_prefs;
@@ -41,15 +41,15 @@ bool software_list::load(QIODevice &stream, QString &error_message)
 	{
 		util::last(m_software).m_parts.shrink_to_fit();
 	});
-	xml.onElementEnd({ "softwarelist", "software", "description" }, [this](std::u8string &&content)
+	xml.onElementEnd({ "softwarelist", "software", "description" }, [this](std::u8string_view content)
 	{
 		util::last(m_software).m_description = util::toQString(content);
 	});
-	xml.onElementEnd({ "softwarelist", "software", "year" }, [this](std::u8string &&content)
+	xml.onElementEnd({ "softwarelist", "software", "year" }, [this](std::u8string_view content)
 	{
 		util::last(m_software).m_year = util::toQString(content);
 	});
-	xml.onElementEnd({ "softwarelist", "software", "publisher" }, [this](std::u8string &&content)
+	xml.onElementEnd({ "softwarelist", "software", "publisher" }, [this](std::u8string_view content)
 	{
 		util::last(m_software).m_publisher = util::toQString(content);
 	});
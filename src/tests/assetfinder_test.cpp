@@ -13,6 +13,7 @@
 
 // Qt headers
 #include <QBuffer>
+#include <QTemporaryDir>
 
 
 namespace
@@ -31,11 +32,15 @@ namespace
 		void loadByCrc_zip_1()			{ loadByCrc(":/resources/sample_archive.zip", "verybig/big1.bin"); }
 		void loadByCrc_zip_2()			{ loadByCrc(":/resources/sample_archive.zip", "verybig/big2.bin"); }
 		void loadByCrc_zip_3()			{ loadByCrc(":/resources/sample_archive.zip", "verybig/big3.bin"); }
+		void assetInfo_zip()			{ assetInfo(":/resources/sample_archive.zip"); }
+		void assetInfo_7zip()			{ assetInfo(":/resources/sample_archive.7z"); }
+		void unreadableCandidate();
 
 	private:
 		void isValidArchive(const char *path, bool expectedResult);
 		void archive(const QString &fileName);
 		void loadByCrc(const QString &fileName, const QString &member);
+		void assetInfo(const QString &fileName);
 	};
 }
 
@@ -131,6 +136,83 @@ void Test::loadByCrc(const QString &fileName, const QString &member)
 }
 
 
+//-------------------------------------------------
+//  assetInfo
+//-------------------------------------------------
+
+void Test::assetInfo(const QString &fileName)
+{
+	AssetFinder assetFinder;
+	assetFinder.setPaths({ fileName });
+
+	// look up by name
+	std::optional<AssetFinder::AssetInfo> info = assetFinder.findAssetInfo("CHaRLie.TXT");
+	QVERIFY(info);
+	QVERIFY(info->m_path == fileName);
+	QVERIFY(info->m_member.compare("charlie.txt", Qt::CaseInsensitive) == 0);
+	QVERIFY(info->m_size == 5);
+	QVERIFY(info->m_crc32 == 0xAFAB3DEB);
+
+	// look up by CRC-32
+	info = assetFinder.findAssetInfo("FIND_CHARLIE_BY_CRC", 0xAFAB3DEB);
+	QVERIFY(info);
+	QVERIFY(info->m_member.compare("charlie.txt", Qt::CaseInsensitive) == 0);
+
+	// sizes should be the uncompressed sizes
+	info = assetFinder.findAssetInfo("verybig/big2.bin");
+	QVERIFY(info);
+	QVERIFY(info->m_size == 110000);
+
+	// unknown file lookups
+	QVERIFY(!assetFinder.findAssetInfo("unknown.txt"));
+}
+
+
+//-------------------------------------------------
+//  unreadableCandidate - findAsset() skips assets
+//	that cannot be opened, and findAssetInfo() has
+//	to pick the same asset that findAsset() does
+//-------------------------------------------------
+
+void Test::unreadableCandidate()
+{
+	// two directories with the same asset
+	QTemporaryDir tempDir1, tempDir2;
+	QVERIFY(tempDir1.isValid());
+	QVERIFY(tempDir2.isValid());
+	QString unreadablePath = tempDir1.filePath("alpha.txt");
+	QString readablePath = tempDir2.filePath("alpha.txt");
+	for (const QString &path : { unreadablePath, readablePath })
+	{
+		QFile file(path);
+		QVERIFY(file.open(QIODevice::WriteOnly));
+		QVERIFY(file.write(path == unreadablePath ? "first" : "second") > 0);
+	}
+
+	// but the first one cannot be read (which is not always possible to arrange)
+	QVERIFY(QFile::setPermissions(unreadablePath, QFileDevice::Permissions()));
+	if (QFile(unreadablePath).open(QIODevice::ReadOnly))
+		QSKIP("Could not make a file unreadable");
+
+	AssetFinder assetFinder;
+	assetFinder.setPaths({ tempDir1.path(), tempDir2.path() });
+
+	// findAsset() should skip the unreadable asset...
+	std::optional<AssetFinder::AssetInfo> openedInfo;
+	std::unique_ptr<QIODevice> stream = assetFinder.findAsset("alpha.txt", { }, &openedInfo);
+	QVERIFY(stream);
+	QVERIFY(stream->readAll() == "second");
+	QVERIFY(openedInfo);
+	QVERIFY(openedInfo->m_path == QFileInfo(readablePath).absoluteFilePath());
+
+	// ...and findAssetInfo() should describe the same one
+	std::optional<AssetFinder::AssetInfo> info = assetFinder.findAssetInfo("alpha.txt");
+	QVERIFY(info);
+	QVERIFY(info->m_path == openedInfo->m_path);
+	QVERIFY(info->m_size == 6);
+}
+
+
 //-------------------------------------------------
 
 static TestFixture<Test> fixture;
@@ -8,6 +8,8 @@
 
 // bletchmame headers
 #include "audit.h"
+#include "assetfinder.h"
+#include "hashcache.h"
 #include "test.h"
 
 // ======================> AuditTask::Test
@@ -24,6 +26,9 @@ private slots:
 	void general_5()				{ general(true,  false, false, false, AuditStatus::Missing); }
 	void general_6()				{ general(true,  true,  true,  true,  AuditStatus::Found); }
 	void addMediaForMachine();
+	void hashCache();
+	void quick();
+	void noHashes();
 
 private:
 	void general(bool hasRom, bool hasNoDumpRom, bool hasSample, bool hasDisk, AuditStatus expectedResult);
@@ -171,6 +176,142 @@ void Audit::Test::addMediaForMachine()
 	QVERIFY(audit.entries()[12].name() == "fakedisk.chd");
 	QVERIFY(audit.entries()[13].type() == Audit::Entry::Type::Sample);
 	QVERIFY(audit.entries()[13].name() == "fakesample.wav");
+
+	// ROMs need both hashes, but samples only need to exist
+	QVERIFY(audit.entries()[ 0].requiresCrc32());
+	QVERIFY(audit.entries()[ 0].requiresSha1());
+	QVERIFY(!audit.entries()[13].requiresCrc32());
+	QVERIFY(!audit.entries()[13].requiresSha1());
+}
+
+
+//-------------------------------------------------
+//  hashCache
+//-------------------------------------------------
+
+void Audit::Test::hashCache()
+{
+	// create a temporary directory with a ROM
+	QTemporaryDir tempDir;
+	QVERIFY(tempDir.isValid());
+	QString romDir = QDir(tempDir.path()).filePath("./rom");
+	QDir().mkdir(romDir);
+	QDir().mkdir(romDir + "/fake");
+	QVERIFY(QFile::copy(":/resources/garbage.bin", romDir + "/fake/garbage.bin"));
+
+	// set up preferences and the machine
+	Preferences prefs;
+	prefs.setGlobalPath(Preferences::global_path_type::ROMS, romDir);
+	info::database db;
+	QVERIFY(db.load(buildInfoDatabase(":/resources/listxml_fake.xml", false)));
+	std::optional<info::machine> machine = db.find_machine("fake");
+	QVERIFY(machine);
+	Audit audit;
+	audit.addMediaForMachine(prefs, *machine);
+
+	// the first audit should calculate the hashes, and put them into the cache
+	HashCache hashCache;
+	std::vector<Audit::Verdict> verdicts;
+	MockAuditCallback callback(verdicts);
+	audit.run(callback, &hashCache);
+	QVERIFY(verdicts.size() == 4);
+	QVERIFY(verdicts[0].type() == Audit::Verdict::Type::Ok);
+
+	AssetFinder assetFinder(QStringList { romDir + "/fake" });
+	std::optional<AssetFinder::AssetInfo> assetInfo = assetFinder.findAssetInfo("garbage.bin");
+	QVERIFY(assetInfo);
+	QVERIFY(hashCache.find(*assetInfo, true, true) == verdicts[0].actualHash());
+
+	// poison the cache; the next audit should trust it and not read the ROM
+	hashCache.store(*assetInfo, Hash(0x12345678, verdicts[0].actualHash().sha1()));
+	verdicts.clear();
+	audit.run(callback, &hashCache);
+	QVERIFY(verdicts.size() == 4);
+	QVERIFY(verdicts[0].type() == Audit::Verdict::Type::Mismatch);
+}
+
+
+//-------------------------------------------------
+//  quick - quick audits should go by the archive
+//	metadata, and never read the assets
+//-------------------------------------------------
+
+void Audit::Test::quick()
+{
+	// a hash function that always fails, so that we know if we read an asset
+	auto failingCalculateHashFunc = [](QIODevice &, bool, bool, const Hash::CalculateCallback &, Hash &)
+	{
+		return Entry::CalculateHashStatus::CantProcess;
+	};
+
+	// set up an audit of the sample archive
+	std::array<std::uint8_t, 20> sha1 = { };
+	Audit audit;
+	int pathsPos = audit.appendPaths(QStringList { ":/resources/sample_archive.zip" });
+	audit.m_entries.emplace_back(Entry::Type::Rom, "charlie.txt", pathsPos, failingCalculateHashFunc, info::rom::dump_status_t::GOOD, 5, Hash(0xAFAB3DEB, sha1), false);
+	audit.m_entries.emplace_back(Entry::Type::Rom, "bravo.txt", pathsPos, failingCalculateHashFunc, info::rom::dump_status_t::GOOD, 5, Hash(0x12345678, sha1), false);
+	audit.m_entries.emplace_back(Entry::Type::Rom, "alpha.txt", pathsPos, failingCalculateHashFunc, info::rom::dump_status_t::GOOD, 6, Hash(0xA0DE71C0, sha1), false);
+
+	// run a quick audit
+	std::vector<Audit::Verdict> verdicts;
+	MockAuditCallback callback(verdicts);
+	std::optional<AuditStatus> result = audit.run(callback, nullptr, true);
+	QVERIFY(result == AuditStatus::Missing);
+	QVERIFY(verdicts.size() == 3);
+	QVERIFY(verdicts[0].type() == Audit::Verdict::Type::OkMetadataVerified);
+	QVERIFY(verdicts[1].type() == Audit::Verdict::Type::Mismatch);
+	QVERIFY(verdicts[2].type() == Audit::Verdict::Type::IncorrectSize);
+
+	// a quick audit that only passes on metadata is reported as such
+	Audit metadataOnlyAudit;
+	pathsPos = metadataOnlyAudit.appendPaths(QStringList { ":/resources/sample_archive.zip" });
+	metadataOnlyAudit.m_entries.emplace_back(Entry::Type::Rom, "charlie.txt", pathsPos, failingCalculateHashFunc, info::rom::dump_status_t::GOOD, 5, Hash(0xAFAB3DEB, sha1), false);
+	verdicts.clear();
+	result = metadataOnlyAudit.run(callback, nullptr, true);
+	QVERIFY(result == AuditStatus::FoundMetadataOnly);
+	QVERIFY(verdicts.size() == 1);
+	QVERIFY(verdicts[0].type() == Audit::Verdict::Type::OkMetadataVerified);
+
+	// whereas a full audit has to read them
+	verdicts.clear();
+	audit.run(callback);
+	QVERIFY(verdicts.size() == 3);
+	QVERIFY(verdicts[0].type() == Audit::Verdict::Type::CouldntProcessAsset);
+	QVERIFY(verdicts[1].type() == Audit::Verdict::Type::CouldntProcessAsset);
+	QVERIFY(verdicts[2].type() == Audit::Verdict::Type::CouldntProcessAsset);
+}
+
+
+//-------------------------------------------------
+//  noHashes - entries that do not need any hashes
+//	(samples, nodumps) should only be checked for
+//	existence and size, and never read
+//-------------------------------------------------
+
+void Audit::Test::noHashes()
+{
+	// a hash function that always fails, so that we know if we read an asset
+	auto failingCalculateHashFunc = [](QIODevice &, bool, bool, const Hash::CalculateCallback &, Hash &)
+	{
+		return Entry::CalculateHashStatus::CantProcess;
+	};
+
+	// set up an audit of the sample archive
+	Audit audit;
+	int pathsPos = audit.appendPaths(QStringList { ":/resources/sample_archive.zip" });
+	audit.m_entries.emplace_back(Entry::Type::Sample, "charlie.txt", pathsPos, failingCalculateHashFunc, info::rom::dump_status_t::GOOD, std::optional<std::uint32_t>(), Hash(), true);
+	audit.m_entries.emplace_back(Entry::Type::Rom, "alpha.txt", pathsPos, failingCalculateHashFunc, info::rom::dump_status_t::NODUMP, 5, Hash(), false);
+	audit.m_entries.emplace_back(Entry::Type::Sample, "echo.txt", pathsPos, failingCalculateHashFunc, info::rom::dump_status_t::GOOD, std::optional<std::uint32_t>(), Hash(), true);
+
+	// and run it
+	std::vector<Audit::Verdict> verdicts;
+	MockAuditCallback callback(verdicts);
+	audit.run(callback);
+	QVERIFY(verdicts.size() == 3);
+	QVERIFY(verdicts[0].type() == Audit::Verdict::Type::Ok);
+	QVERIFY(verdicts[0].actualSize() == 5);
+	QVERIFY(verdicts[1].type() == Audit::Verdict::Type::OkNoGoodDump);
+	QVERIFY(verdicts[2].type() == Audit::Verdict::Type::NotFound);
 }
 
 
@@ -8,12 +8,16 @@
 
 // bletchmame headers
 #include "hash.h"
+#include "pipedevice.h"
 #include "test.h"
 
 // Qt headers
 #include <QBuffer>
 #include <QTest>
 
+// standard headers
+#include <vector>
+
 
 //**************************************************************************
 //  TYPE DECLARATIONS
@@ -26,14 +30,38 @@ class Hash::Test : public QObject
 private slots:
 	void calculate();
 	void calculateForEmptyFile();
+	void calculateSubset_00()	{ calculateSubset(false, false, ""); }
+	void calculateSubset_01()	{ calculateSubset(false, true, "SHA1(c27909184ee9170707c1be9a4cfbe83b359672e1)"); }
+	void calculateSubset_10()	{ calculateSubset(true, false, "CRC(0faf9fdb)"); }
+	void calculateSubset_11()	{ calculateSubset(true, true, "CRC(0faf9fdb) SHA1(c27909184ee9170707c1be9a4cfbe83b359672e1)"); }
 	void handleBadRead();
 	void mask_00()	{ mask(false, false, ""); }
 	void mask_01()	{ mask(false, true, "SHA1(0123456789abcdef0123456789abcdef01234567)"); }
 	void mask_10()	{ mask(true, false, "CRC(0123abcd)"); }
 	void mask_11()	{ mask(true, true, "CRC(0123abcd) SHA1(0123456789abcdef0123456789abcdef01234567)"); }
+	void crc32Engines();
+	void benchmarkCrc32_bytewise()		{ benchmarkCrc32(Crc32Engine::Bytewise); }
+	void benchmarkCrc32_slicingBy16()	{ benchmarkCrc32(Crc32Engine::SlicingBy16); }
+	void benchmarkCrc32_pclmul()		{ benchmarkCrc32(Crc32Engine::Pclmul); }
+	void benchmarkCrc32_armv8()			{ benchmarkCrc32(Crc32Engine::Armv8); }
+	void sha1Engines();
+	void calculateInPieces();
+	void benchmarkSha1_scalar()			{ benchmarkSha1(Sha1Engine::Scalar); }
+	void benchmarkSha1_shaNi()			{ benchmarkSha1(Sha1Engine::ShaNi); }
+	void benchmarkSha1_armv8()			{ benchmarkSha1(Sha1Engine::Armv8); }
+	void benchmarkCalculate();
 
 private:
+	static constexpr std::array s_allCrc32Engines = { Crc32Engine::Bytewise, Crc32Engine::SlicingBy16, Crc32Engine::Pclmul, Crc32Engine::Armv8 };
+	static constexpr std::array s_allSha1Engines = { Sha1Engine::Scalar, Sha1Engine::ShaNi, Sha1Engine::Armv8 };
+
+	void calculateSubset(bool useCrc32, bool useSha1, const char *expected);
 	void mask(bool useCrc32, bool useSha1, const char *expected);
+	void benchmarkCrc32(Crc32Engine engine);
+	void benchmarkSha1(Sha1Engine engine);
+	static std::array<std::uint8_t, 20> sha1(Sha1Function function, const std::uint8_t *data, std::size_t size);
+	static std::array<std::uint8_t, 20> sha1(Sha1Function function, const char *string);
+	static std::vector<std::uint8_t> createTestData(std::size_t size);
 };
 
 
@@ -90,6 +118,28 @@ void Hash::Test::calculateForEmptyFile()
 }
 
 
+//-------------------------------------------------
+//  calculateSubset
+//-------------------------------------------------
+
+void Hash::Test::calculateSubset(bool useCrc32, bool useSha1, const char *expected)
+{
+	// get a resource
+	QFile file(":/resources/garbage.bin");
+	QVERIFY(file.open(QIODevice::ReadOnly));
+
+	// process hashes
+	std::optional<Hash> hash = Hash::calculate(file, dummyCallback, useCrc32, useSha1);
+	QVERIFY(hash);
+
+	// verify the results
+	QVERIFY(hash->toString() == expected);
+
+	// if we did not ask for any hashes, the file should not have been read
+	QVERIFY(file.pos() == (useCrc32 || useSha1 ? file.size() : 0));
+}
+
+
 //-------------------------------------------------
 //  handleBadRead
 //-------------------------------------------------
@@ -127,6 +177,200 @@ void Hash::Test::mask(bool useCrc32, bool useSha1, const char *expected)
 }
 
 
+//-------------------------------------------------
+//  crc32Engines - every engine that this CPU
+//	supports must be bit-exact with the reference
+//	for all sizes and alignments
+//-------------------------------------------------
+
+void Hash::Test::crc32Engines()
+{
+	Crc32Function reference = crc32Function(Crc32Engine::Bytewise);
+	QVERIFY(reference);
+	QVERIFY(bestCrc32Function());
+
+	std::vector<std::uint8_t> data = createTestData(100000);
+	for (Crc32Engine engine : s_allCrc32Engines)
+	{
+		Crc32Function function = crc32Function(engine);
+		if (!function)
+			continue;
+
+		// the standard check value
+		QVERIFY((function(~0, (const std::uint8_t *)"123456789", 9) ^ ~0) == 0xCBF43926);
+
+		// short runs, at each alignment
+		for (std::size_t offset = 0; offset < 16; offset++)
+		{
+			for (std::size_t size = 0; size < 300; size++)
+				QVERIFY(function(~0, &data[offset], size) == reference(~0, &data[offset], size));
+		}
+
+		// a long run, in one piece and in two
+		std::uint32_t expected = reference(~0, data.data(), data.size());
+		QVERIFY(function(~0, data.data(), data.size()) == expected);
+		QVERIFY(function(function(~0, data.data(), 1001), data.data() + 1001, data.size() - 1001) == expected);
+	}
+}
+
+
+//-------------------------------------------------
+//  benchmarkCrc32 - throughput on a buffer the
+//	size of a large ROM
+//-------------------------------------------------
+
+void Hash::Test::benchmarkCrc32(Crc32Engine engine)
+{
+	Crc32Function function = crc32Function(engine);
+	if (!function)
+		QSKIP("CRC32 engine not supported on this CPU");
+
+	std::vector<std::uint8_t> data = createTestData(16 * 1024 * 1024);
+	std::uint32_t crc = ~0;
+	QBENCHMARK
+	{
+		crc = function(crc, data.data(), data.size());
+	}
+}
+
+
+//-------------------------------------------------
+//  sha1Engines - every engine that this CPU
+//	supports must match the published test vectors
+//	and the scalar engine
+//-------------------------------------------------
+
+void Hash::Test::sha1Engines()
+{
+	Sha1Function reference = sha1Function(Sha1Engine::Scalar);
+	QVERIFY(reference);
+	QVERIFY(bestSha1Function());
+
+	std::vector<std::uint8_t> data = createTestData(100000);
+	for (Sha1Engine engine : s_allSha1Engines)
+	{
+		Sha1Function function = sha1Function(engine);
+		if (!function)
+			continue;
+
+		// test vectors from FIPS 180
+		QVERIFY(Hash(sha1(function, "")).toString() == "SHA1(da39a3ee5e6b4b0d3255bfef95601890afd80709)");
+		QVERIFY(Hash(sha1(function, "abc")).toString() == "SHA1(a9993e364706816aba3e25717850c26c9cd0d89d)");
+		QVERIFY(Hash(sha1(function, "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq")).toString() == "SHA1(84983e441c3bd26ebaae4aa1f95129e5e54670f1)");
+
+		// every size around the block and padding boundaries, and a long run
+		for (std::size_t size = 0; size < 300; size++)
+			QVERIFY(sha1(function, data.data(), size) == sha1(reference, data.data(), size));
+		QVERIFY(sha1(function, data.data(), data.size()) == sha1(reference, data.data(), data.size()));
+	}
+}
+
+
+//-------------------------------------------------
+//  calculateInPieces - reads that do not line up
+//	with SHA-1 blocks must not change the results
+//-------------------------------------------------
+
+void Hash::Test::calculateInPieces()
+{
+	std::vector<std::uint8_t> data = createTestData(300000);
+	QByteArray byteArray((const char *)data.data(), data.size());
+
+	// calculate in one go
+	QBuffer buffer(&byteArray);
+	QVERIFY(buffer.open(QIODevice::ReadOnly));
+	std::optional<Hash> expected = Hash::calculate(buffer, dummyCallback);
+	QVERIFY(expected);
+
+	// and with reads of awkward sizes
+	PipeDevice pipe(data.size());
+	QVERIFY(pipe.open(QIODevice::ReadOnly | QIODevice::Unbuffered));
+	for (qsizetype position = 0, size = 1; position < byteArray.size(); position += size, size = size * 7 % 1009 + 1)
+		pipe.pushBuffer(byteArray.mid(position, size));
+	pipe.finish();
+	std::optional<Hash> actual = Hash::calculate(pipe, dummyCallback);
+	QVERIFY(actual);
+	QVERIFY(*actual == *expected);
+}
+
+
+//-------------------------------------------------
+//  benchmarkSha1
+//-------------------------------------------------
+
+void Hash::Test::benchmarkSha1(Sha1Engine engine)
+{
+	Sha1Function function = sha1Function(engine);
+	if (!function)
+		QSKIP("SHA-1 engine not supported on this CPU");
+
+	std::vector<std::uint8_t> data = createTestData(16 * 1024 * 1024);
+	std::array<std::uint32_t, 5> state = SHA1_INITIAL_STATE;
+	QBENCHMARK
+	{
+		function(state, data.data(), data.size() / 64);
+	}
+}
+
+
+//-------------------------------------------------
+//  benchmarkCalculate - CRC32 and SHA-1 together,
+//	as used when auditing
+//-------------------------------------------------
+
+void Hash::Test::benchmarkCalculate()
+{
+	std::vector<std::uint8_t> data = createTestData(16 * 1024 * 1024);
+	QByteArray byteArray((const char *)data.data(), data.size());
+	QBENCHMARK
+	{
+		QBuffer buffer(&byteArray);
+		QVERIFY(buffer.open(QIODevice::ReadOnly));
+		QVERIFY(Hash::calculate(buffer, dummyCallback));
+	}
+}
+
+
+//-------------------------------------------------
+//  sha1
+//-------------------------------------------------
+
+std::array<std::uint8_t, 20> Hash::Test::sha1(Sha1Function function, const std::uint8_t *data, std::size_t size)
+{
+	std::array<std::uint32_t, 5> state = SHA1_INITIAL_STATE;
+	std::size_t blocksSize = size / 64 * 64;
+	function(state, data, blocksSize / 64);
+	return finishSha1(state, function, data + blocksSize, size - blocksSize, size);
+}
+
+
+//-------------------------------------------------
+//  sha1
+//-------------------------------------------------
+
+std::array<std::uint8_t, 20> Hash::Test::sha1(Sha1Function function, const char *string)
+{
+	return sha1(function, (const std::uint8_t *)string, strlen(string));
+}
+
+
+//-------------------------------------------------
+//  createTestData
+//-------------------------------------------------
+
+std::vector<std::uint8_t> Hash::Test::createTestData(std::size_t size)
+{
+	std::vector<std::uint8_t> result(size);
+	std::uint32_t seed = 0x12345678;
+	for (std::uint8_t &b : result)
+	{
+		seed = seed * 1664525 + 1013904223;
+		b = (std::uint8_t)(seed >> 24);
+	}
+	return result;
+}
+
+
 //-------------------------------------------------
 
 static TestFixture<Hash::Test> fixture;
@@ -0,0 +1,204 @@
+/***************************************************************************
+
+	hashcache_test.cpp
+
+	Unit tests for hashcache.cpp
+
+***************************************************************************/
+
+// bletchmame headers
+#include "hashcache.h"
+#include "test.h"
+
+// Qt headers
+#include <QTemporaryDir>
+
+// standard headers
+#include <thread>
+
+
+// ======================> HashCache::Test
+
+class HashCache::Test : public QObject
+{
+	Q_OBJECT
+
+private slots:
+	void general();
+	void partialHashes();
+	void tornWrite();
+	void concurrentWriters();
+
+private:
+	static AssetFinder::AssetInfo assetInfo(const QString &path, std::uint64_t size = 1234);
+	static Hash hash(std::uint32_t crc32, std::uint8_t sha1Byte);
+};
+
+
+//**************************************************************************
+//  IMPLEMENTATION
+//**************************************************************************
+
+//-------------------------------------------------
+//  assetInfo
+//-------------------------------------------------
+
+AssetFinder::AssetInfo HashCache::Test::assetInfo(const QString &path, std::uint64_t size)
+{
+	return AssetFinder::AssetInfo { path, "member.bin", size, QDateTime::fromMSecsSinceEpoch(1660000000000), std::nullopt };
+}
+
+
+//-------------------------------------------------
+//  hash
+//-------------------------------------------------
+
+Hash HashCache::Test::hash(std::uint32_t crc32, std::uint8_t sha1Byte)
+{
+	std::array<std::uint8_t, 20> sha1;
+	sha1.fill(sha1Byte);
+	return Hash(crc32, sha1);
+}
+
+
+//-------------------------------------------------
+//  general - hashes survive being reloaded, and
+//	are keyed by the size and time too
+//-------------------------------------------------
+
+void HashCache::Test::general()
+{
+	QTemporaryDir tempDir;
+	QVERIFY(tempDir.isValid());
+	QString cachePath = tempDir.filePath("hashes.cache");
+
+	// store some hashes
+	{
+		HashCache hashCache(cachePath);
+		QVERIFY(!hashCache.find(assetInfo("foo.zip"), true, true));
+		hashCache.store(assetInfo("foo.zip"), hash(0x12345678, 0xAA));
+		hashCache.store(assetInfo("bar.zip"), hash(0x23456789, 0xBB));
+		hashCache.store(assetInfo("bar.zip"), hash(0x3456789A, 0xCC));
+		QVERIFY(hashCache.find(assetInfo("foo.zip"), true, true) == hash(0x12345678, 0xAA));
+	}
+
+	// and read them back
+	HashCache hashCache(cachePath);
+	QVERIFY(hashCache.find(assetInfo("foo.zip"), true, true) == hash(0x12345678, 0xAA));
+	QVERIFY(hashCache.find(assetInfo("bar.zip"), true, true) == hash(0x3456789A, 0xCC));
+	QVERIFY(hashCache.find(assetInfo("foo.zip"), true, false) == hash(0x12345678, 0xAA).mask(true, false));
+	QVERIFY(!hashCache.find(assetInfo("baz.zip"), true, true));
+	QVERIFY(!hashCache.find(assetInfo("foo.zip", 4321), true, true));
+
+	AssetFinder::AssetInfo touchedAssetInfo = assetInfo("foo.zip");
+	touchedAssetInfo.m_lastModified = touchedAssetInfo.m_lastModified.addSecs(1);
+	QVERIFY(!hashCache.find(touchedAssetInfo, true, true));
+}
+
+
+//-------------------------------------------------
+//  partialHashes - only the hashes that were
+//	calculated are cached
+//-------------------------------------------------
+
+void HashCache::Test::partialHashes()
+{
+	QTemporaryDir tempDir;
+	QVERIFY(tempDir.isValid());
+	HashCache hashCache(tempDir.filePath("hashes.cache"));
+
+	// store just the CRC32
+	hashCache.store(assetInfo("foo.zip"), hash(0x12345678, 0xAA).mask(true, false));
+	QVERIFY(hashCache.find(assetInfo("foo.zip"), true, false) == hash(0x12345678, 0xAA).mask(true, false));
+	QVERIFY(!hashCache.find(assetInfo("foo.zip"), false, true));
+	QVERIFY(!hashCache.find(assetInfo("foo.zip"), true, true));
+
+	// and then the SHA-1; the two should be merged
+	hashCache.store(assetInfo("foo.zip"), hash(0x12345678, 0xAA).mask(false, true));
+	QVERIFY(hashCache.find(assetInfo("foo.zip"), true, true) == hash(0x12345678, 0xAA));
+}
+
+
+//-------------------------------------------------
+//  tornWrite - a record cut short should not
+//	spoil the records before it, or the ones that
+//	are appended afterwards
+//-------------------------------------------------
+
+void HashCache::Test::tornWrite()
+{
+	QTemporaryDir tempDir;
+	QVERIFY(tempDir.isValid());
+	QString cachePath = tempDir.filePath("hashes.cache");
+
+	// store a hash
+	{
+		HashCache hashCache(cachePath);
+		hashCache.store(assetInfo("foo.zip"), hash(0x12345678, 0xAA));
+	}
+
+	// simulate a writer that died partway through a record
+	{
+		QFile file(cachePath);
+		QVERIFY(file.open(QIODevice::Append));
+		QVERIFY(file.write(QByteArray(10, '\x42')) == 10);
+	}
+
+	// store another hash
+	{
+		HashCache hashCache(cachePath);
+		QVERIFY(hashCache.find(assetInfo("foo.zip"), true, true) == hash(0x12345678, 0xAA));
+		hashCache.store(assetInfo("bar.zip"), hash(0x23456789, 0xBB));
+	}
+
+	// and both should be there
+	HashCache hashCache(cachePath);
+	QVERIFY(hashCache.find(assetInfo("foo.zip"), true, true) == hash(0x12345678, 0xAA));
+	QVERIFY(hashCache.find(assetInfo("bar.zip"), true, true) == hash(0x23456789, 0xBB));
+}
+
+
+//-------------------------------------------------
+//  concurrentWriters
+//-------------------------------------------------
+
+void HashCache::Test::concurrentWriters()
+{
+	const int THREAD_COUNT = 8;
+	const int HASHES_PER_THREAD = 200;
+	auto fileName = [](int i, int j) { return QString::number(i) + "_" + QString::number(j) + ".zip"; };
+
+	QTemporaryDir tempDir;
+	QVERIFY(tempDir.isValid());
+	QString cachePath = tempDir.filePath("hashes.cache");
+
+	// store hashes from many threads at once
+	{
+		HashCache hashCache(cachePath);
+		std::vector<std::thread> threads;
+		for (int i = 0; i < THREAD_COUNT; i++)
+		{
+			threads.emplace_back([&hashCache, &fileName, i]
+			{
+				for (int j = 0; j < HASHES_PER_THREAD; j++)
+					hashCache.store(assetInfo(fileName(i, j)), hash(i * HASHES_PER_THREAD + j, (std::uint8_t)i));
+			});
+		}
+		for (std::thread &thread : threads)
+			thread.join();
+	}
+
+	// and read them all back
+	HashCache hashCache(cachePath);
+	for (int i = 0; i < THREAD_COUNT; i++)
+	{
+		for (int j = 0; j < HASHES_PER_THREAD; j++)
+			QVERIFY(hashCache.find(assetInfo(fileName(i, j)), true, true) == hash(i * HASHES_PER_THREAD + j, (std::uint8_t)i));
+	}
+}
+
+
+//-------------------------------------------------
+
+static TestFixture<HashCache::Test> fixture;
+#include "hashcache_test.moc"
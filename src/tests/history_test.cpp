@@ -11,6 +11,11 @@
 #include "utility.h"
 #include "test.h"
 
+// Qt headers
+#include <QBuffer>
+#include <QFile>
+#include <QTemporaryDir>
+
 
 // ======================> HistoryDatabase::Test
 
@@ -20,6 +25,9 @@ class HistoryDatabase::Test : public QObject
 
 private slots:
 	void general();
+	void parallel();
+	void parallelFallback();
+	void cache();
 	void toRichText_1() { return toRichText(u8"", ""); }
 	void toRichText_2() { return toRichText(u8"foo bar", "foo bar"); }
 	void toRichText_3() { return toRichText(u8"foo\nbar", "foo<br/>bar"); }
@@ -34,6 +42,7 @@ private slots:
 
 private:
 	void toRichText(std::u8string_view text, const QString &expected);
+	static void checkChunkedLoad(const QByteArray &xml, int chunkCount);
 };
 
 
@@ -78,6 +87,147 @@ void HistoryDatabase::Test::general()
 }
 
 
+//-------------------------------------------------
+//  parallel - ensures that splitting history.xml
+//	into chunks yields the same results as parsing
+//	it sequentially
+//-------------------------------------------------
+
+void HistoryDatabase::Test::parallel()
+{
+	QFile file(":/resources/history.xml");
+	QVERIFY(file.open(QIODevice::ReadOnly));
+	QByteArray xml = file.readAll();
+
+	for (int chunkCount = 1; chunkCount <= 8; chunkCount++)
+		checkChunkedLoad(xml, chunkCount);
+}
+
+
+//-------------------------------------------------
+//  parallelFallback - an "<entry" in a comment
+//	fools the splitter, but should not change the
+//	results
+//-------------------------------------------------
+
+void HistoryDatabase::Test::parallelFallback()
+{
+	QByteArray xml = "<?xml version=\"1.0\"?>\n"
+		"<history>\n"
+		"\t<entry><systems><system name=\"alpha\" /></systems><text>Alpha</text></entry>\n"
+		"\t<!-- <entry> -->\n"
+		"\t<entry><systems><system name=\"bravo\" /></systems><text>Bravo</text></entry>\n"
+		"\t<entry><systems><system name=\"alpha\" /></systems><text>Charlie</text></entry>\n"
+		"</history>\n";
+
+	for (int chunkCount = 1; chunkCount <= 4; chunkCount++)
+		checkChunkedLoad(xml, chunkCount);
+}
+
+
+//-------------------------------------------------
+//  checkChunkedLoad
+//-------------------------------------------------
+
+void HistoryDatabase::Test::checkChunkedLoad(const QByteArray &xml, int chunkCount)
+{
+	// load sequentially
+	QBuffer buffer;
+	buffer.setData(xml);
+	QVERIFY(buffer.open(QIODevice::ReadOnly));
+	HistoryDatabase expected;
+	QVERIFY(expected.load(buffer));
+
+	// and in chunks
+	HistoryDatabase actual;
+	QVERIFY(actual.load(std::span<const char>(xml.constData(), xml.size()), chunkCount));
+	QVERIFY(actual.m_ownedData == expected.m_ownedData);
+}
+
+
+//-------------------------------------------------
+//  cache
+//-------------------------------------------------
+
+void HistoryDatabase::Test::cache()
+{
+	using namespace std::literals;
+
+	// set up a temporary history.xml
+	QTemporaryDir tempDir;
+	QVERIFY(tempDir.isValid());
+	QString xmlPath = tempDir.filePath("history.xml");
+	QString cachePath = tempDir.filePath("history.cache");
+	QFile resourceFile(":/resources/history.xml");
+	QVERIFY(resourceFile.open(QIODevice::ReadOnly));
+	QByteArray xml = resourceFile.readAll();
+	{
+		QFile xmlFile(xmlPath);
+		QVERIFY(xmlFile.open(QIODevice::WriteOnly));
+		QVERIFY(xmlFile.write(xml) == xml.size());
+	}
+
+	// the first load parses history.xml and writes the cache
+	HistoryDatabase parsed;
+	QVERIFY(parsed.load(xmlPath, cachePath));
+	QVERIFY(!parsed.m_mappedFile);
+	QVERIFY(QFile::exists(cachePath));
+
+	// the second load maps the cache
+	HistoryDatabase cached;
+	QVERIFY(cached.load(xmlPath, cachePath));
+	QVERIFY(cached.m_mappedFile);
+	QVERIFY(cached.get(MachineIdentifier(u8"rampage"sv)).size() == 11284);
+	QVERIFY(cached.get(MachineIdentifier(u8"rampage"sv)) == parsed.get(MachineIdentifier(u8"rampage"sv)));
+	QVERIFY(cached.get(SoftwareIdentifier(u8"nes"sv, u8"zelda"sv)).size() == 537);
+	QVERIFY(cached.get(SoftwareIdentifier(u8"nes"sv, u8"dummy"sv)).empty());
+
+	// unmapping it keeps the contents, but releases the cache so that it can be rewritten
+	cached.unmap();
+	QVERIFY(!cached.m_mappedFile);
+	QVERIFY(cached.get(MachineIdentifier(u8"rampage"sv)) == parsed.get(MachineIdentifier(u8"rampage"sv)));
+	QVERIFY(cached.get(SoftwareIdentifier(u8"nes"sv, u8"zelda"sv)).size() == 537);
+
+	// changing history.xml invalidates the cache
+	{
+		QFile xmlFile(xmlPath);
+		QVERIFY(xmlFile.open(QIODevice::WriteOnly | QIODevice::Append));
+		QVERIFY(xmlFile.write("\n") == 1);
+	}
+	HistoryDatabase reparsed;
+	QVERIFY(reparsed.load(xmlPath, cachePath));
+	QVERIFY(!reparsed.m_mappedFile);
+	QVERIFY(reparsed.get(SoftwareIdentifier(u8"nes"sv, u8"zelda"sv)).size() == 537);
+	QVERIFY(cached.get(SoftwareIdentifier(u8"nes"sv, u8"zelda"sv)).size() == 537);
+
+	// a cache in another format version is ignored
+	{
+		QFile cacheFile(cachePath);
+		QVERIFY(cacheFile.open(QIODevice::ReadWrite));
+		Header header;
+		QVERIFY(cacheFile.read((char *)&header, sizeof(header)) == sizeof(header));
+		header.m_formatVersion = FORMAT_VERSION + 1;
+		QVERIFY(cacheFile.seek(0));
+		QVERIFY(cacheFile.write((const char *)&header, sizeof(header)) == sizeof(header));
+	}
+	HistoryDatabase otherVersion;
+	QVERIFY(otherVersion.load(xmlPath, cachePath));
+	QVERIFY(!otherVersion.m_mappedFile);
+	QVERIFY(otherVersion.get(MachineIdentifier(u8"rampage"sv)).size() == 11284);
+
+	// and a damaged cache is ignored
+	{
+		QFile cacheFile(cachePath);
+		QVERIFY(cacheFile.open(QIODevice::ReadWrite));
+		QVERIFY(cacheFile.resize(cacheFile.size() / 2));
+	}
+	HistoryDatabase damaged;
+	QVERIFY(damaged.load(xmlPath, cachePath));
+	QVERIFY(!damaged.m_mappedFile);
+	QVERIFY(damaged.get(MachineIdentifier(u8"rampage"sv)).size() == 11284);
+}
+
+
 //-------------------------------------------------
 //  toRichText
 //-------------------------------------------------
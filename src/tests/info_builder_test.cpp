@@ -27,7 +27,12 @@ private slots:
 	void compareBinaries_alienar()	{ compareBinaries(":/resources/listxml_alienar.xml"); }
 	void compareBinaries_coco()		{ compareBinaries(":/resources/listxml_coco.xml"); }
 	void compareBinaries_fake()		{ compareBinaries(":/resources/listxml_fake.xml"); }
+	void compressedColdTables();
+	void mergeShards();
+	void mergeIntoEmptyShard();
+	void capacityPlan();
 	void stringTable();
+	void stringTableGrowth();
 	void singleString1()			{ singleString<const char8_t *>(u8""); }
 	void singleString2()			{ singleString<const char8_t *>(u8"A"); }
 	void singleString3()			{ singleString<const char8_t *>(u8"BC"); }
@@ -119,6 +124,55 @@ QByteArray buildInfoDatabase(const QString &fileName, bool skipDtd)
 }
 
 
+//-------------------------------------------------
+//  splitListXml - splits -listxml output into
+//	shards, much like MAME would emit when invoked
+//	with patterns; machines are dealt out round
+//	robin, and devices end up in every shard
+//-------------------------------------------------
+
+std::vector<QByteArray> splitListXml(const QString &fileName, int shardCount)
+{
+	// read the file
+	QFile file(fileName);
+	if (!file.open(QFile::ReadOnly))
+		return { };
+	QByteArray xml = file.readAll();
+
+	// everything before the first machine is common to all shards
+	qsizetype machinesBegin = xml.indexOf("<machine ");
+	qsizetype machinesEnd = xml.lastIndexOf("</mame>");
+	if (machinesBegin < 0 || machinesEnd < machinesBegin)
+		return { };
+	std::vector<QByteArray> results(shardCount, xml.left(machinesBegin));
+
+	// deal out the machines
+	int machineIndex = 0;
+	qsizetype position = machinesBegin;
+	while (position < machinesEnd)
+	{
+		qsizetype nextPosition = xml.indexOf("<machine ", position + 1);
+		if (nextPosition < 0 || nextPosition > machinesEnd)
+			nextPosition = machinesEnd;
+		QByteArray machine = xml.mid(position, nextPosition - position);
+
+		bool isDevice = machine.left(machine.indexOf('>')).contains("isdevice=\"yes\"");
+		for (int shard = 0; shard < shardCount; shard++)
+		{
+			if (isDevice || machineIndex % shardCount == shard)
+				results[shard] += machine;
+		}
+		machineIndex++;
+		position = nextPosition;
+	}
+
+	// and close them all out
+	for (QByteArray &result : results)
+		result += "</mame>\n";
+	return results;
+}
+
+
 //-------------------------------------------------
 //  general
 //-------------------------------------------------
@@ -188,6 +242,293 @@ void info::database_builder::Test::compareBinaries(const QString &fileName)
 }
 
 
+//-------------------------------------------------
+//  compressedColdTables - builds a database with
+//	the cold tables forcibly compressed, and checks
+//	that they read back identically
+//-------------------------------------------------
+
+void info::database_builder::Test::compressedColdTables()
+{
+	// build the database normally (the cold tables in listxml_coco.xml are too small to be compressed)
+	QByteArray byteArray = buildInfoDatabase();
+	QVERIFY(byteArray.size() > 0);
+
+	// and build it again, compressing everything
+	QByteArray compressedByteArray;
+	{
+		QFile file(":/resources/listxml_coco.xml");
+		QVERIFY(file.open(QFile::ReadOnly));
+
+		info::database_builder builder;
+		builder.m_compressionThreshold = 0;
+		QString errorMessage;
+		QVERIFY(builder.process_xml(file, errorMessage));
+
+		QBuffer buffer(&compressedByteArray);
+		QVERIFY(buffer.open(QIODevice::WriteOnly));
+		builder.emit_info(buffer);
+	}
+	QVERIFY(compressedByteArray.size() > 0);
+	QVERIFY(compressedByteArray.size() < byteArray.size());
+
+	// load them both
+	info::database db;
+	info::database compressedDb;
+	QVERIFY(db.load(byteArray));
+	QVERIFY(compressedDb.load(compressedByteArray));
+	QVERIFY(compressedDb.machines().size() == db.machines().size());
+
+	// and compare the cold tables
+	QVERIFY(compressedDb.chips().size() == db.chips().size());
+	for (std::size_t i = 0; i < db.chips().size(); i++)
+	{
+		QVERIFY(compressedDb.chips()[i].name() == db.chips()[i].name());
+		QVERIFY(compressedDb.chips()[i].tag() == db.chips()[i].tag());
+		QVERIFY(compressedDb.chips()[i].type() == db.chips()[i].type());
+		QVERIFY(compressedDb.chips()[i].clock() == db.chips()[i].clock());
+	}
+	QVERIFY(compressedDb.displays().size() == db.displays().size());
+	for (std::size_t i = 0; i < db.displays().size(); i++)
+	{
+		QVERIFY(compressedDb.displays()[i].type() == db.displays()[i].type());
+	}
+	QVERIFY(compressedDb.configurations().size() == db.configurations().size());
+	for (std::size_t i = 0; i < db.configurations().size(); i++)
+	{
+		QVERIFY(compressedDb.configurations()[i].name() == db.configurations()[i].name());
+		QVERIFY(compressedDb.configurations()[i].tag() == db.configurations()[i].tag());
+		QVERIFY(compressedDb.configurations()[i].mask() == db.configurations()[i].mask());
+	}
+	QVERIFY(compressedDb.configuration_settings().size() == db.configuration_settings().size());
+	for (std::size_t i = 0; i < db.configuration_settings().size(); i++)
+	{
+		QVERIFY(compressedDb.configuration_settings()[i].name() == db.configuration_settings()[i].name());
+		QVERIFY(compressedDb.configuration_settings()[i].value() == db.configuration_settings()[i].value());
+	}
+	QVERIFY(compressedDb.configuration_conditions().size() == db.configuration_conditions().size());
+	for (std::size_t i = 0; i < db.configuration_conditions().size(); i++)
+	{
+		QVERIFY(compressedDb.configuration_conditions()[i].tag() == db.configuration_conditions()[i].tag());
+		QVERIFY(compressedDb.configuration_conditions()[i].relation() == db.configuration_conditions()[i].relation());
+		QVERIFY(compressedDb.configuration_conditions()[i].mask() == db.configuration_conditions()[i].mask());
+		QVERIFY(compressedDb.configuration_conditions()[i].value() == db.configuration_conditions()[i].value());
+	}
+}
+
+
+//-------------------------------------------------
+//  mergeShards - builds a database from shards of
+//	-listxml output, and checks that it matches a
+//	database built normally
+//-------------------------------------------------
+
+void info::database_builder::Test::mergeShards()
+{
+	// build the database normally
+	QByteArray byteArray = buildInfoDatabase();
+	QVERIFY(byteArray.size() > 0);
+
+	// and build it again from shards
+	std::vector<QByteArray> shards = splitListXml(":/resources/listxml_coco.xml", 3);
+	QVERIFY(shards.size() == 3);
+	QByteArray mergedByteArray;
+	{
+		std::vector<info::database_builder> builders;
+		for (QByteArray &shard : shards)
+		{
+			QBuffer buffer(&shard);
+			QVERIFY(buffer.open(QIODevice::ReadOnly));
+			QString errorMessage;
+			QVERIFY(builders.emplace_back((int)shards.size()).parse_xml(buffer, errorMessage));
+		}
+		for (std::size_t i = 1; i < builders.size(); i++)
+			builders[0].merge(builders[i]);
+		builders[0].finalize();
+
+		QBuffer buffer(&mergedByteArray);
+		QVERIFY(buffer.open(QIODevice::WriteOnly));
+		builders[0].emit_info(buffer);
+	}
+
+	// load them both
+	info::database db;
+	info::database mergedDb;
+	QVERIFY(db.load(byteArray));
+	QVERIFY(mergedDb.load(mergedByteArray));
+	QVERIFY(mergedDb.version() == db.version());
+	QVERIFY(mergedDb.machines().size() == db.machines().size());
+
+	// and compare the machines
+	auto machineName = [](const std::optional<info::machine> &machine)
+	{
+		return machine ? machine->name() : QString();
+	};
+	for (std::size_t i = 0; i < db.machines().size(); i++)
+	{
+		info::machine machine = db.machines()[i];
+		info::machine mergedMachine = mergedDb.machines()[i];
+		QVERIFY(mergedMachine.name() == machine.name());
+		QVERIFY(mergedMachine.description() == machine.description());
+		QVERIFY(mergedMachine.year() == machine.year());
+		QVERIFY(mergedMachine.manufacturer() == machine.manufacturer());
+		QVERIFY(mergedMachine.sourcefile() == machine.sourcefile());
+		QVERIFY(machineName(mergedMachine.clone_of()) == machineName(machine.clone_of()));
+		QVERIFY(machineName(mergedMachine.rom_of()) == machineName(machine.rom_of()));
+		QVERIFY(mergedMachine.roms_size() == machine.roms_size());
+		QVERIFY(mergedMachine.clones().size() == machine.clones().size());
+		QVERIFY(mergedMachine.dependents().size() == machine.dependents().size());
+		QVERIFY(mergedMachine.chips().size() == machine.chips().size());
+		QVERIFY(mergedMachine.devices().size() == machine.devices().size());
+		QVERIFY(mergedMachine.configurations().size() == machine.configurations().size());
+
+		QVERIFY(mergedMachine.roms().size() == machine.roms().size());
+		for (std::size_t j = 0; j < machine.roms().size(); j++)
+		{
+			QVERIFY(mergedMachine.roms()[j].name() == machine.roms()[j].name());
+			QVERIFY(mergedMachine.roms()[j].crc32() == machine.roms()[j].crc32());
+		}
+
+		QVERIFY(mergedMachine.devslots().size() == machine.devslots().size());
+		for (std::size_t j = 0; j < machine.devslots().size(); j++)
+		{
+			QVERIFY(mergedMachine.devslots()[j].options().size() == machine.devslots()[j].options().size());
+			for (std::size_t k = 0; k < machine.devslots()[j].options().size(); k++)
+			{
+				info::slot_option option = machine.devslots()[j].options()[k];
+				info::slot_option mergedOption = mergedMachine.devslots()[j].options()[k];
+				QVERIFY(mergedOption.name() == option.name());
+				QVERIFY(machineName(mergedOption.machine()) == machineName(option.machine()));
+			}
+		}
+	}
+}
+
+
+//-------------------------------------------------
+//  mergeIntoEmptyShard - merges shards into a
+//	builder that parsed nothing (MAME emits nothing
+//	for a shard without any matching machines) and
+//	checks that the build is carried over
+//-------------------------------------------------
+
+void info::database_builder::Test::mergeIntoEmptyShard()
+{
+	// build the database normally
+	QByteArray byteArray = buildInfoDatabase();
+	QVERIFY(byteArray.size() > 0);
+
+	// and build it again from shards, merged into an empty builder
+	std::vector<QByteArray> shards = splitListXml(":/resources/listxml_coco.xml", 2);
+	QVERIFY(shards.size() == 2);
+	QByteArray mergedByteArray;
+	{
+		std::vector<info::database_builder> builders;
+		builders.emplace_back((int)shards.size() + 1);
+		for (QByteArray &shard : shards)
+		{
+			QBuffer buffer(&shard);
+			QVERIFY(buffer.open(QIODevice::ReadOnly));
+			QString errorMessage;
+			QVERIFY(builders.emplace_back((int)shards.size() + 1).parse_xml(buffer, errorMessage));
+		}
+		for (std::size_t i = 1; i < builders.size(); i++)
+			builders[0].merge(builders[i]);
+		builders[0].finalize();
+
+		QBuffer buffer(&mergedByteArray);
+		QVERIFY(buffer.open(QIODevice::WriteOnly));
+		builders[0].emit_info(buffer);
+	}
+
+	// load them both, and check the build
+	info::database db;
+	info::database mergedDb;
+	QVERIFY(db.load(byteArray));
+	QVERIFY(mergedDb.load(mergedByteArray));
+	QVERIFY(!db.version().isEmpty());
+	QVERIFY(mergedDb.version() == db.version());
+	QVERIFY(mergedDb.machines().size() == db.machines().size());
+}
+
+
+//-------------------------------------------------
+//  capacityPlan - ensures that a builder sized from
+//	a previous info DB's header does not need to
+//	reallocate any of its tables
+//-------------------------------------------------
+
+void info::database_builder::Test::capacityPlan()
+{
+	// build the database normally
+	QByteArray byteArray = buildInfoDatabase();
+	QVERIFY(byteArray.size() > 0);
+
+	// read its header
+	std::optional<info::binaries::header> header;
+	{
+		QBuffer buffer(&byteArray);
+		QVERIFY(buffer.open(QIODevice::ReadOnly));
+		header = info::database::read_header(buffer);
+	}
+	QVERIFY(header.has_value());
+	QVERIFY(header->m_machines_count > 0);
+	QVERIFY(header->m_roms_count > 0);
+
+	// garbage should not be mistaken for a header
+	{
+		QByteArray garbage(sizeof(info::binaries::header), 'X');
+		QBuffer buffer(&garbage);
+		QVERIFY(buffer.open(QIODevice::ReadOnly));
+		QVERIFY(!info::database::read_header(buffer).has_value());
+	}
+
+	// nor should a header from another format version; the last two bytes of the salt
+	// are the version, and they overlay the last two bytes of the magic number
+	{
+		QByteArray otherVersion = byteArray.left(sizeof(info::binaries::header));
+		otherVersion[6] = (char)(otherVersion[6] ^ 0x01);
+		QBuffer buffer(&otherVersion);
+		QVERIFY(buffer.open(QIODevice::ReadOnly));
+		QVERIFY(!info::database::read_header(buffer).has_value());
+	}
+
+	// parse the same -listxml output with a plan based on that header
+	info::database_builder builder;
+	builder.plan_capacity(*header);
+	QFile file(":/resources/listxml_coco.xml");
+	QVERIFY(file.open(QFile::ReadOnly));
+	QString errorMessage;
+	QVERIFY(builder.parse_xml(file, errorMessage));
+
+	// every table should have been reserved (with headroom) up front
+	auto verifyTable = [](const auto &table, std::uint32_t count)
+	{
+		QVERIFY(table.size() == count);
+		QVERIFY(table.capacity() >= count + count / 16);
+	};
+	verifyTable(builder.m_machines,					header->m_machines_count);
+	verifyTable(builder.m_biossets,					header->m_biossets_count);
+	verifyTable(builder.m_roms,						header->m_roms_count);
+	verifyTable(builder.m_disks,					header->m_disks_count);
+	verifyTable(builder.m_devices,					header->m_devices_count);
+	verifyTable(builder.m_slots,					header->m_slots_count);
+	verifyTable(builder.m_slot_options,				header->m_slot_options_count);
+	verifyTable(builder.m_features,					header->m_features_count);
+	verifyTable(builder.m_chips,					header->m_chips_count);
+	verifyTable(builder.m_displays,					header->m_displays_count);
+	verifyTable(builder.m_samples,					header->m_samples_count);
+	verifyTable(builder.m_configurations,			header->m_configurations_count);
+	verifyTable(builder.m_configuration_settings,	header->m_configuration_settings_count);
+	verifyTable(builder.m_configuration_conditions,	header->m_configuration_conditions_count);
+	verifyTable(builder.m_software_lists,			header->m_software_lists_count);
+	verifyTable(builder.m_ram_options,				header->m_ram_options_count);
+
+	// and so nothing should have been reallocated while parsing
+	QVERIFY(builder.m_reallocation_count == 0);
+}
+
+
 //-------------------------------------------------
 //  stringTable
 //-------------------------------------------------
@@ -233,6 +574,39 @@ void info::database_builder::Test::stringTable()
 }
 
 
+//-------------------------------------------------
+//  stringTableGrowth - adds enough strings to make
+//	the hash table grow a few times
+//-------------------------------------------------
+
+void info::database_builder::Test::stringTableGrowth()
+{
+	const int stringCount = 300000;
+	auto makeString = [](int i)
+	{
+		return std::u8string(u8"string #") + util::toU8String(QString::number(i));
+	};
+
+	// add the strings (twice)
+	string_table stringTable;
+	std::vector<std::uint32_t> indexes;
+	indexes.reserve(stringCount);
+	for (int i = 0; i < stringCount; i++)
+		indexes.push_back(stringTable.get(makeString(i)));
+	for (int i = 0; i < stringCount; i++)
+		QVERIFY(stringTable.get(makeString(i)) == indexes[i]);
+
+	// every string should have been stored once
+	std::ranges::sort(indexes);
+	QVERIFY(std::ranges::adjacent_find(indexes) == indexes.end());
+
+	// and validate that the lookups work
+	string_table::SsoBuffer sso;
+	for (int i = 0; i < stringCount; i += 997)
+		QVERIFY(stringTable.lookup(stringTable.get(makeString(i)), sso) == makeString(i));
+}
+
+
 //-------------------------------------------------
 //  singleString
 //-------------------------------------------------
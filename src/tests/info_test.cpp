@@ -12,6 +12,12 @@
 
 // Qt headers
 #include <QBuffer>
+#include <QTemporaryDir>
+
+// standard headers
+#include <map>
+#include <set>
+#include <thread>
 
 
 namespace
@@ -41,6 +47,13 @@ namespace
 		void loadGarbage_1000_1000()		{ loadGarbage(1000, 1000); }
 		void loadFailuresDontMutate();
 		void readsAllBytes();
+		void loadFromFile();
+		void concurrentStrings();
+		void machineGroups();
+		void clonesAndDependents();
+		void romsSize();
+		void findRomsByCrc();
+		void findDisksBySha1();
 		void sortable();
 		void localeSensitivity();
 		void scrutinize_alienar();
@@ -134,7 +147,8 @@ void Test::general(const QString &fileName, bool skipDtd, int expectedMachineCou
 			slotCount++;
 			for (info::slot_option opt : slot.options())
 			{
-				(void)opt;
+				// the machine resolved at build time should match a lookup by device name
+				QVERIFY(opt.machine() == db.find_machine(opt.devname()));
 				slotOptionCount++;
 			}
 		}
@@ -175,6 +189,12 @@ void Test::machineLookup(const QString &fileName)
 		QVERIFY(foundMachine->year() == machine.year());
 		QVERIFY(foundMachine->description() == machine.description());
 		QVERIFY(foundMachine->devices().size() == machine.devices().size());
+
+		// the UTF-8 lookup should behave the same
+		std::u8string machineName = util::toU8String(machine.name());
+		std::optional<info::machine> foundMachineUtf8 = db.find_machine(std::u8string_view(machineName));
+		QVERIFY(foundMachineUtf8);
+		QVERIFY(foundMachineUtf8->name() == machine.name());
 	}
 }
 
@@ -191,6 +211,13 @@ void Test::badMachineLookup()
 
 	std::optional<info::machine> result = db.find_machine("this_is_an_invalid_machine");
 	QVERIFY(!result);
+
+	// near misses of legitimate machine names, including ones encoded as small strings
+	QVERIFY(!db.find_machine(std::u8string_view(u8"")));
+	QVERIFY(!db.find_machine(std::u8string_view(u8"coco2c")));
+	QVERIFY(!db.find_machine(std::u8string_view(u8"coco2bx")));
+	QVERIFY(!db.find_machine(std::u8string_view(u8"COCO")));
+	QVERIFY(db.find_machine(std::u8string_view(u8"coco")));
 }
 
 
@@ -219,7 +246,26 @@ void Test::deviceLookup(const QString &fileName, const QString &machineName)
 		QVERIFY(foundDevice);
 		QVERIFY(foundDevice->tag() == device.tag());
 		QVERIFY(foundDevice->type() == device.type());
+
+		// and again without going through QString
+		QByteArray tagUtf8 = device.tag().toUtf8();
+		std::optional<info::device> foundDeviceUtf8 = machine->find_device(std::u8string_view((const char8_t *)tagUtf8.constData(), (size_t)tagUtf8.size()));
+		QVERIFY(foundDeviceUtf8);
+		QVERIFY(foundDeviceUtf8->tag() == device.tag());
 	}
+
+	// for all chips...
+	for (info::chip chip : machine->chips())
+	{
+		// ...look it up
+		std::optional<info::chip> foundChip = machine->find_chip(chip.name());
+		QVERIFY(foundChip);
+		QVERIFY(foundChip->name() == chip.name());
+	}
+
+	// and lookups that should fail
+	QVERIFY(!machine->find_device(std::u8string_view(u8"nonexistent")));
+	QVERIFY(!machine->find_chip(std::u8string_view(u8"Nonexistent Chip")));
 }
 
 
@@ -482,6 +528,279 @@ void Test::readsAllBytes()
 }
 
 
+//-------------------------------------------------
+//  loadFromFile - loading by file name memory maps
+//	the file; ensure that this is equivalent to
+//	loading from a buffer
+//-------------------------------------------------
+
+void Test::loadFromFile()
+{
+	// build a DB and write it out to a file
+	QByteArray byteArray = buildInfoDatabase();
+	QVERIFY(byteArray.size() > 0);
+	QTemporaryDir tempDir;
+	QVERIFY(tempDir.isValid());
+	QString fileName = tempDir.filePath("test.info");
+	{
+		QFile file(fileName);
+		QVERIFY(file.open(QIODevice::WriteOnly));
+		QVERIFY(file.write(byteArray) == byteArray.size());
+	}
+
+	// load it both ways
+	info::database bufferDb;
+	QVERIFY(bufferDb.load(byteArray));
+	info::database fileDb;
+	QVERIFY(fileDb.load(fileName));
+
+	// and compare
+	QVERIFY(fileDb.version() == bufferDb.version());
+	QVERIFY(fileDb.machines().size() == bufferDb.machines().size());
+	for (size_t i = 0; i < fileDb.machines().size(); i++)
+	{
+		QVERIFY(fileDb.machines()[i].name() == bufferDb.machines()[i].name());
+		QVERIFY(fileDb.machines()[i].description() == bufferDb.machines()[i].description());
+		QVERIFY(fileDb.machines()[i].roms().size() == bufferDb.machines()[i].roms().size());
+	}
+	QVERIFY(fileDb.find_machine("coco2b"));
+
+	// a truncated file should fail to load, and not mutate the DB
+	QString badFileName = tempDir.filePath("bad.info");
+	{
+		QFile file(badFileName);
+		QVERIFY(file.open(QIODevice::WriteOnly));
+		QVERIFY(file.write(byteArray.left(byteArray.size() / 2)) == byteArray.size() / 2);
+	}
+	size_t machineCount = fileDb.machines().size();
+	QVERIFY(!fileDb.load(badFileName));
+	QVERIFY(fileDb.machines().size() == machineCount);
+	QVERIFY(fileDb.find_machine("coco2b"));
+
+	// as should a file from another MAME version, or one that does not exist
+	QVERIFY(!fileDb.load(fileName, "0.999 (mame0999)"));
+	QVERIFY(!fileDb.load(tempDir.filePath("missing.info")));
+	QVERIFY(fileDb.machines().size() == machineCount);
+	QVERIFY(fileDb.find_machine("coco2b"));
+}
+
+
+//-------------------------------------------------
+//  concurrentStrings - ensure that strings can be
+//	decoded from multiple threads, and that they all
+//	get the same cached string
+//-------------------------------------------------
+
+void Test::concurrentStrings()
+{
+	info::database db;
+	QVERIFY(db.load(buildInfoDatabase()));
+	QVERIFY(db.machines().size() > 0);
+
+	// have a number of threads decode strings simultaneously
+	const int threadCount = 8;
+	std::vector<std::vector<const QString *>> results(threadCount);
+	std::vector<std::thread> threads;
+	for (int i = 0; i < threadCount; i++)
+	{
+		threads.emplace_back([&db, &result = results[i]]()
+		{
+			for (info::machine machine : db.machines())
+			{
+				result.push_back(&machine.name());
+				result.push_back(&machine.description());
+				for (info::rom rom : machine.roms())
+					result.push_back(&rom.name());
+			}
+		});
+	}
+	for (std::thread &thread : threads)
+		thread.join();
+
+	// every thread should have gotten the exact same references
+	for (int i = 1; i < threadCount; i++)
+		QVERIFY(results[i] == results[0]);
+	QVERIFY(&db.machines()[0].name() == results[0][0]);
+}
+
+
+//-------------------------------------------------
+//  machineGroups - validate the machine groups
+//	against a scan of all machines
+//-------------------------------------------------
+
+void Test::machineGroups()
+{
+	info::database db;
+	QVERIFY(db.load(buildInfoDatabase()));
+	QVERIFY(db.machines().size() > 0);
+
+	// determine what the manufacturer and CPU groups should look like
+	std::map<QString, std::set<std::uint32_t>> expectedManufacturers, expectedCpus;
+	for (info::machine machine : db.machines())
+	{
+		if (machine.runnable())
+		{
+			expectedManufacturers[machine.manufacturer()].insert(machine.index());
+			for (info::chip chip : machine.chips())
+			{
+				if (chip.type() == info::chip::type_t::CPU)
+					expectedCpus[chip.name()].insert(machine.index());
+			}
+		}
+	}
+
+	// and compare against what is in the DB
+	auto checkGroups = [&db](const info::machine_group::view &groups, const std::map<QString, std::set<std::uint32_t>> &expected)
+	{
+		QVERIFY(groups.size() == expected.size());
+		for (info::machine_group group : groups)
+		{
+			auto iter = expected.find(group.name());
+			QVERIFY(iter != expected.end());
+
+			std::set<std::uint32_t> actual;
+			for (info::machine machine : group.machines())
+				actual.insert(machine.index());
+			QVERIFY(actual == iter->second);
+
+			for (info::machine machine : db.machines())
+				QVERIFY(group.contains(machine) == iter->second.contains(machine.index()));
+		}
+	};
+	checkGroups(db.manufacturer_groups(), expectedManufacturers);
+	checkGroups(db.cpu_groups(), expectedCpus);
+}
+
+
+//-------------------------------------------------
+//  clonesAndDependents
+//-------------------------------------------------
+
+void Test::clonesAndDependents()
+{
+	info::database db;
+	QVERIFY(db.load(buildInfoDatabase()));
+	QVERIFY(db.machines().size() > 0);
+
+	for (info::machine parent : db.machines())
+	{
+		// determine what the clones and dependents should be
+		std::vector<std::uint32_t> expectedClones, expectedDependents;
+		for (info::machine machine : db.machines())
+		{
+			if (machine.clone_of() == parent)
+				expectedClones.push_back(machine.index());
+			if (machine.rom_of() == parent)
+				expectedDependents.push_back(machine.index());
+		}
+
+		// and compare
+		std::vector<std::uint32_t> actualClones, actualDependents;
+		for (info::machine machine : parent.clones())
+			actualClones.push_back(machine.index());
+		for (info::machine machine : parent.dependents())
+			actualDependents.push_back(machine.index());
+		QVERIFY(actualClones == expectedClones);
+		QVERIFY(actualDependents == expectedDependents);
+	}
+
+	// spot check
+	std::optional<info::machine> coco = db.find_machine("coco");
+	QVERIFY(coco);
+	QVERIFY(std::ranges::any_of(coco->clones(), [](info::machine machine) { return machine.name() == "coco2"; }));
+}
+
+
+//-------------------------------------------------
+//  romsSize
+//-------------------------------------------------
+
+void Test::romsSize()
+{
+	info::database db;
+	QVERIFY(db.load(buildInfoDatabase()));
+	QVERIFY(db.machines().size() > 0);
+
+	for (info::machine machine : db.machines())
+	{
+		std::uint64_t expectedRomsSize = 0, expectedOwnRomsSize = 0;
+		for (info::rom rom : machine.roms())
+		{
+			expectedRomsSize += rom.size();
+			if (rom.merge().isEmpty())
+				expectedOwnRomsSize += rom.size();
+		}
+		QVERIFY(machine.roms_size() == expectedRomsSize);
+		QVERIFY(machine.own_roms_size() == expectedOwnRomsSize);
+	}
+
+	// spot check - cocoh gets its BASIC ROM from coco
+	std::optional<info::machine> cocoh = db.find_machine("cocoh");
+	QVERIFY(cocoh);
+	QVERIFY(cocoh->roms_size() == 8192);
+	QVERIFY(cocoh->own_roms_size() == 0);
+}
+
+
+//-------------------------------------------------
+//  findRomsByCrc
+//-------------------------------------------------
+
+void Test::findRomsByCrc()
+{
+	info::database db;
+	QVERIFY(db.load(buildInfoDatabase()));
+	QVERIFY(db.roms_by_crc().size() > 0);
+
+	// every dumped ROM should be found by its CRC32, along with the machine that has it
+	for (info::machine machine : db.machines())
+	{
+		for (info::rom rom : machine.roms())
+		{
+			if (rom.status() == info::rom::dump_status_t::NODUMP)
+				continue;
+
+			info::rom_by_crc::view results = db.find_roms_by_crc(rom.crc32());
+			QVERIFY(!results.empty());
+			QVERIFY(std::ranges::all_of(results, [&rom](info::rom_by_crc x) { return x.crc32() == rom.crc32() && x.rom().crc32() == rom.crc32(); }));
+			QVERIFY(std::ranges::any_of(results, [&machine, &rom](info::rom_by_crc x) { return x.machine() == machine && x.rom().name() == rom.name(); }));
+		}
+	}
+
+	// spot check
+	info::rom_by_crc::view results = db.find_roms_by_crc(0x54368805);
+	QVERIFY(std::ranges::any_of(results, [](info::rom_by_crc x) { return x.machine().name() == "coco2" && x.rom().name() == "bas12.rom"; }));
+
+	// and something that is not there
+	QVERIFY(db.find_roms_by_crc(0xDEADBEEF).empty());
+}
+
+
+//-------------------------------------------------
+//  findDisksBySha1
+//-------------------------------------------------
+
+void Test::findDisksBySha1()
+{
+	info::database db;
+	QVERIFY(db.load(buildInfoDatabase(":/resources/listxml_alienar.xml")));
+
+	// this disk was manually added to the listxml
+	const std::array<std::uint8_t, 20> sha1 = { 0x01, 0x23, 0x45, 0x67, 0x89, 0xAB, 0xCD, 0xEF, 0x01, 0x23, 0x45, 0x67, 0x89, 0xAB, 0xCD, 0xEF, 0x01, 0x23, 0x45, 0x67 };
+	info::disk_by_sha1::view results = db.find_disks_by_sha1(sha1);
+	QVERIFY(results.size() == 1);
+	QVERIFY(results[0].sha1() == sha1);
+	QVERIFY(results[0].disk().name() == "fakedisk");
+	QVERIFY(results[0].machine().name() == "alienar");
+
+	// and something that is not there
+	std::array<std::uint8_t, 20> otherSha1 = sha1;
+	otherSha1[19]++;
+	QVERIFY(db.find_disks_by_sha1(otherSha1).empty());
+}
+
+
 //-------------------------------------------------
 //  sortable - not really about sorting but rather
 //	ensuring that the info/bindata copy/move/assignment
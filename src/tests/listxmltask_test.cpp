@@ -8,9 +8,13 @@
 
 // bletchmame headers
 #include "listxmltask.h"
+#include "info.h"
 #include "test.h"
 
 // Qt headers
+#include <QBuffer>
+#include <QDir>
+#include <QProcess>
 #include <QTemporaryDir>
 
 
@@ -20,7 +24,10 @@ class ListXmlTask::Test : public QObject
 
 private slots:
 	void internalRun();
+	void internalRunSharded();
+	void internalRunShardedProcesses();
 	void pathWithFile();
+	void shardPatterns();
 };
 
 
@@ -54,6 +61,109 @@ void ListXmlTask::Test::internalRun()
 }
 
 
+//-------------------------------------------------
+//  internalRunSharded
+//-------------------------------------------------
+
+void ListXmlTask::Test::internalRunSharded()
+{
+	QTemporaryDir tempDir;
+	QString outputPath = tempDir.filePath("foo.infodb");
+
+	// create a task
+	auto task = ListXmlTask(QString(outputPath), 4);
+
+	// split the test asset into three shards, along with a shard that did not match anything
+	std::vector<QByteArray> shards = splitListXml(":/resources/listxml_coco.xml", 3);
+	QVERIFY(shards.size() == 3);
+	shards.emplace_back();
+
+	// and set up "processes" for them
+	std::vector<std::unique_ptr<QBuffer>> buffers;
+	std::vector<QIODevice *> processes;
+	for (QByteArray &shard : shards)
+	{
+		std::unique_ptr<QBuffer> &buffer = buffers.emplace_back(std::make_unique<QBuffer>(&shard));
+		QVERIFY(buffer->open(QIODevice::ReadOnly));
+		processes.push_back(buffer.get());
+	}
+
+	// process!
+	std::optional<ListXmlError> caughtError = task.internalRun(processes);
+	QVERIFY(!caughtError);
+
+	// and verify that we got all of the machines
+	info::database expectedDb;
+	info::database db;
+	QVERIFY(expectedDb.load(buildInfoDatabase()));
+	QVERIFY(db.load(outputPath));
+	QVERIFY(db.machines().size() == expectedDb.machines().size());
+	for (info::machine machine : expectedDb.machines())
+		QVERIFY(db.find_machine(machine.name()));
+}
+
+
+//-------------------------------------------------
+//  internalRunShardedProcesses - like
+//	internalRunSharded, but with real processes that
+//	stall partway through their output
+//-------------------------------------------------
+
+void ListXmlTask::Test::internalRunShardedProcesses()
+{
+	QTemporaryDir tempDir;
+	QString outputPath = tempDir.filePath("foo.infodb");
+
+	// create a task
+	auto task = ListXmlTask(QString(outputPath), 4);
+
+	// split the test asset into three shards, along with a shard that did not match anything
+	std::vector<QByteArray> shards = splitListXml(":/resources/listxml_coco.xml", 3);
+	QVERIFY(shards.size() == 3);
+	shards.emplace_back();
+
+	// each shard is emitted by a process that writes out half of it, pauses, and then writes out the rest
+	std::vector<std::unique_ptr<QProcess>> shardProcesses;
+	std::vector<QIODevice *> processes;
+	for (std::size_t i = 0; i < shards.size(); i++)
+	{
+		QStringList halfFileNames;
+		for (int half = 0; half < 2; half++)
+		{
+			QString halfFileName = QString("shard%1_%2.xml").arg(i).arg(half);
+			QFile halfFile(tempDir.filePath(halfFileName));
+			QVERIFY(halfFile.open(QFile::WriteOnly));
+			qsizetype halfSize = shards[i].size() / 2;
+			halfFile.write(half == 0 ? shards[i].left(halfSize) : shards[i].mid(halfSize));
+			halfFileNames << halfFileName;
+		}
+
+		std::unique_ptr<QProcess> &process = shardProcesses.emplace_back(std::make_unique<QProcess>());
+		process->setWorkingDirectory(tempDir.path());
+#ifdef Q_OS_WIN
+		process->start("cmd", QStringList() << "/c" << QString("type %1& ping -n 2 127.0.0.1 >nul& type %2").arg(halfFileNames[0], halfFileNames[1]));
+#else
+		process->start("sh", QStringList() << "-c" << QString("cat %1; sleep 1; cat %2").arg(halfFileNames[0], halfFileNames[1]));
+#endif
+		QVERIFY(process->waitForStarted());
+		processes.push_back(process.get());
+	}
+
+	// process!
+	std::optional<ListXmlError> caughtError = task.internalRun(processes);
+	QVERIFY(!caughtError);
+
+	// and verify that we got all of the machines, including the ones after the pause
+	info::database expectedDb;
+	info::database db;
+	QVERIFY(expectedDb.load(buildInfoDatabase()));
+	QVERIFY(db.load(outputPath));
+	QVERIFY(db.machines().size() == expectedDb.machines().size());
+	for (info::machine machine : expectedDb.machines())
+		QVERIFY(db.find_machine(machine.name()));
+}
+
+
 //-------------------------------------------------
 //  pathWithFile
 //-------------------------------------------------
@@ -84,5 +194,31 @@ void ListXmlTask::Test::pathWithFile()
 }
 
 
+//-------------------------------------------------
+//  shardPatterns - every machine name prefix needs
+//	to be in exactly one shard
+//-------------------------------------------------
+
+void ListXmlTask::Test::shardPatterns()
+{
+	QVERIFY(ListXmlTask::shardPatterns(0, 1).isEmpty());
+
+	for (int shardCount : { 2, 5, 36 })
+	{
+		QStringList allPatterns;
+		for (int shard = 0; shard < shardCount; shard++)
+		{
+			QStringList patterns = ListXmlTask::shardPatterns(shard, shardCount);
+			QVERIFY(!patterns.isEmpty());
+			allPatterns << patterns;
+		}
+		QVERIFY(allPatterns.size() == 36);
+		QVERIFY(allPatterns.removeDuplicates() == 0);
+		QVERIFY(allPatterns.contains("a*"));
+		QVERIFY(allPatterns.contains("0*"));
+	}
+}
+
+
 static TestFixture<ListXmlTask::Test> fixture;
 #include "listxmltask_test.moc"
@@ -0,0 +1,184 @@
+/***************************************************************************
+
+	pipedevice_test.cpp
+
+	Unit tests for pipedevice.cpp
+
+***************************************************************************/
+
+// bletchmame headers
+#include "pipedevice.h"
+#include "test.h"
+
+// Qt headers
+#include <QBuffer>
+#include <QProcess>
+
+// standard headers
+#include <thread>
+
+
+class PipeDevice::Test : public QObject
+{
+	Q_OBJECT
+
+private slots:
+	void readAll();
+	void pumpFrom();
+	void pumpStepSlowProcess();
+	void cancel();
+};
+
+
+//**************************************************************************
+//  IMPLEMENTATION
+//**************************************************************************
+
+//-------------------------------------------------
+//  createTestData
+//-------------------------------------------------
+
+static QByteArray createTestData(int size)
+{
+	QByteArray result;
+	result.reserve(size);
+	for (int i = 0; i < size; i++)
+		result.append((char)(i * 7 + i / 256));
+	return result;
+}
+
+
+//-------------------------------------------------
+//  readAll - pushes data in chunks from one thread
+//	and reads it in differently sized chunks from
+//	another
+//-------------------------------------------------
+
+void PipeDevice::Test::readAll()
+{
+	QByteArray testData = createTestData(100000);
+
+	// a small pipe, so that the producer has to block
+	PipeDevice pipe(2);
+	QVERIFY(pipe.open(QIODevice::ReadOnly | QIODevice::Unbuffered));
+
+	std::thread producer([&pipe, &testData]
+	{
+		for (qsizetype pos = 0; pos < testData.size(); pos += 3000)
+			pipe.pushBuffer(testData.mid(pos, 3000));
+		pipe.finish();
+	});
+
+	QByteArray result;
+	char buffer[1234];
+	qint64 lastRead;
+	while ((lastRead = pipe.read(buffer, sizeof(buffer))) > 0)
+		result.append(buffer, lastRead);
+	producer.join();
+
+	QVERIFY(result == testData);
+	QVERIFY(!pipe.waitForReadyRead(-1));
+}
+
+
+//-------------------------------------------------
+//  pumpFrom
+//-------------------------------------------------
+
+void PipeDevice::Test::pumpFrom()
+{
+	QByteArray testData = createTestData(100000);
+	QBuffer source(&testData);
+	QVERIFY(source.open(QIODevice::ReadOnly));
+
+	PipeDevice pipe(2);
+	QVERIFY(pipe.open(QIODevice::ReadOnly | QIODevice::Unbuffered));
+
+	std::thread producer([&pipe, &source]
+	{
+		pipe.pumpFrom(source, 4096);
+	});
+
+	QByteArray result;
+	char buffer[5000];
+	qint64 lastRead;
+	while ((lastRead = pipe.read(buffer, sizeof(buffer))) > 0)
+		result.append(buffer, lastRead);
+	producer.join();
+
+	QVERIFY(result == testData);
+}
+
+
+//-------------------------------------------------
+//  pumpStepSlowProcess - pumps from a process that
+//	goes quiet for longer than pumpStep() waits,
+//	which should not be mistaken for the end
+//-------------------------------------------------
+
+void PipeDevice::Test::pumpStepSlowProcess()
+{
+	QProcess process;
+	process.setReadChannel(QProcess::StandardOutput);
+#ifdef Q_OS_WIN
+	process.start("cmd", QStringList() << "/c" << "echo first& ping -n 2 127.0.0.1 >nul& echo second");
+#else
+	process.start("sh", QStringList() << "-c" << "echo first; sleep 1; echo second");
+#endif
+	QVERIFY(process.waitForStarted());
+
+	PipeDevice pipe;
+	QVERIFY(pipe.open(QIODevice::ReadOnly | QIODevice::Unbuffered));
+
+	QByteArray result;
+	std::thread consumer([&pipe, &result]
+	{
+		char buffer[256];
+		qint64 lastRead;
+		while ((lastRead = pipe.read(buffer, sizeof(buffer))) > 0)
+			result.append(buffer, lastRead);
+	});
+
+	while (pipe.pumpStep(process, 10))
+		;
+	consumer.join();
+
+	QVERIFY(process.state() == QProcess::NotRunning);
+	QVERIFY(result.contains("first"));
+	QVERIFY(result.contains("second"));
+}
+
+
+//-------------------------------------------------
+//  cancel - ensures that a consumer cancelling
+//	unblocks the producer
+//-------------------------------------------------
+
+void PipeDevice::Test::cancel()
+{
+	PipeDevice pipe(1);
+	QVERIFY(pipe.open(QIODevice::ReadOnly | QIODevice::Unbuffered));
+
+	// the producer will fill the pipe and then block
+	bool lastPushResult = true;
+	std::thread producer([&pipe, &lastPushResult]
+	{
+		while (lastPushResult)
+			lastPushResult = pipe.pushBuffer(QByteArray("abcd"));
+	});
+
+	// read a bit, and then cancel
+	char buffer[4];
+	QVERIFY(pipe.read(buffer, sizeof(buffer)) == 4);
+	pipe.cancel();
+	producer.join();
+
+	QVERIFY(!lastPushResult);
+	QVERIFY(pipe.read(buffer, sizeof(buffer)) < 0);
+}
+
+
+//-------------------------------------------------
+
+static TestFixture<PipeDevice::Test> fixture;
+#include "pipedevice_test.moc"
@@ -101,6 +101,7 @@ void Preferences::Test::general(bool regurgitate)
 	QVERIFY(prefs.getRecentDeviceFiles("echo", "floppy").size()									== 0);
 	QVERIFY(prefs.getRecentDeviceFiles("foxtrot", "cassette").size()							== 0);
 	QVERIFY(prefs.getRecentDeviceFiles("foxtrot", "cassette").size()							== 0);
+	QVERIFY(prefs.getListXmlProcessCount()														== 2);
 }
 
 
@@ -203,6 +204,8 @@ void Preferences::Test::defaults()
 	QVERIFY(prefs.getWindowState()										== WindowState::Normal);
 	QVERIFY(prefs.getSelectedTab()										== list_view_type::MACHINE);
 	QVERIFY(prefs.getAuditingState()									== AuditingState::Default);
+	QVERIFY(prefs.getQuickAuditing()									== false);
+	QVERIFY(prefs.getListXmlProcessCount()								== 0);
 	QVERIFY(prefs.getGlobalPath(global_path_type::EMU_EXECUTABLE)		== "");
 	QVERIFY(prefs.getGlobalPath(global_path_type::ROMS)					== "");
 	QVERIFY(prefs.getGlobalPath(global_path_type::SAMPLES)				== "");
@@ -20,6 +20,7 @@
 #include <functional>
 #include <memory>
 #include <optional>
+#include <vector>
 
 
 // ======================> TestFixtureBase
@@ -69,6 +70,7 @@ int runAndExcerciseListXml(int argc, char *argv[], bool sequential, int run_coun
 
 // helper functions
 QByteArray buildInfoDatabase(const QString &fileName = ":/resources/listxml_coco.xml", bool skipDtd = false);
+std::vector<QByteArray> splitListXml(const QString &fileName, int shardCount);
 std::optional<QImageReader::ImageReaderError> tryLoadImage(const QString& fileName);
 
 #endif // TEST_H
@@ -10,6 +10,10 @@
 #include "xmlparser.h"
 #include "test.h"
 
+// Qt headers
+#include <QBuffer>
+#include <QTemporaryDir>
+
 
 class XmlParser::Test : public QObject
 {
@@ -24,6 +28,12 @@ private slots:
 	void recursive();
 	void localeSensitivity();
 	void xmlParsingError();
+	void compileTimeAttributes();
+	void contentView();
+	void longElementNames();
+	void parseMapped();
+	void benchmarkAttributes_runtime()		{ benchmarkAttributes(false); }
+	void benchmarkAttributes_compileTime()	{ benchmarkAttributes(true); }
 
 	void attributeParsingError_int_1()		{ attributeParsingError<int>("<alpha><bravo value=\"NOT_AN_INTEGER\"/></alpha>"); }
 	void attributeParsingError_int_2()		{ attributeParsingError<int>("<alpha><bravo value=\"42_NOT_AN_INTEGER_42\"/></alpha>"); }
@@ -34,6 +44,7 @@ private slots:
 
 private:
 	template<class T> void attributeParsingError(const char *xml);
+	void benchmarkAttributes(bool compileTime);
 };
 
 
@@ -334,6 +345,220 @@ void XmlParser::Test::xmlParsingError()
 }
 
 
+//-------------------------------------------------
+//  compileTimeAttributes - checks that get<>() and
+//	get() agree
+//-------------------------------------------------
+
+void XmlParser::Test::compileTimeAttributes()
+{
+	XmlParser xml;
+	int invocations = 0;
+	bool allMatch = true;
+	xml.onElementBegin({ "alpha", "bravo" }, [&](const XmlParser::Attributes &attributes)
+	{
+		const auto runtimeAttrs = attributes.get("name", "size", "sha1", "status", "region", "s", "");
+		const auto compileTimeAttrs = attributes.get<"name", "size", "sha1", "status", "region", "s", "">();
+		for (std::size_t i = 0; i < runtimeAttrs.size(); i++)
+		{
+			allMatch = allMatch
+				&& (bool)runtimeAttrs[i] == (bool)compileTimeAttrs[i]
+				&& runtimeAttrs[i].as<std::u8string_view>() == compileTimeAttrs[i].as<std::u8string_view>();
+		}
+		invocations++;
+	});
+
+	const char *xmlText =
+		"<alpha>"
+		"<bravo name=\"abc.bin\" size=\"4096\" sha1=\"0123456789abcdef0123456789abcdef01234567\" region=\"maincpu\"/>"
+		"<bravo status=\"nodump\" s=\"short\" sizes=\"not_size\" nam=\"not_name\" shal=\"not_sha1\"/>"
+		"<bravo/>"
+		"</alpha>";
+	QVERIFY(xml.parseBytes(xmlText, strlen(xmlText)));
+	QVERIFY(invocations == 3);
+	QVERIFY(allMatch);
+}
+
+
+//-------------------------------------------------
+//  contentView - checks content handed to
+//	std::u8string_view callbacks, both when it is
+//	in one piece and when it is not
+//-------------------------------------------------
+
+void XmlParser::Test::contentView()
+{
+	// content that spans expat's buffers
+	std::u8string bigContent;
+	for (int i = 0; bigContent.size() < 300000; i++)
+		bigContent += u8"abcdefghijklmnopqrstuvwxyz0123456789"[i % 36];
+
+	XmlParser xml;
+	std::vector<std::u8string> bravoValues;
+	std::vector<std::u8string> charlieValues;
+	xml.onElementEnd({ "alpha", "bravo" }, [&](std::u8string_view content)
+	{
+		bravoValues.emplace_back(content);
+	});
+	xml.onElementEnd({ "alpha", "charlie" }, [&](std::u8string &&content)
+	{
+		charlieValues.push_back(std::move(content));
+	});
+
+	std::u8string xmlText = u8"<alpha>"
+		u8"<bravo>simple</bravo>"
+		u8"<bravo>fish &amp; chips</bravo>"
+		u8"<bravo>line one\r\nline two</bravo>"
+		u8"<bravo></bravo>"
+		u8"<bravo>" + bigContent + u8"</bravo>"
+		u8"<charlie>after the big one</charlie>"
+		u8"</alpha>";
+	QVERIFY(xml.parseBytes(xmlText.data(), xmlText.size()));
+
+	QVERIFY(bravoValues.size() == 5);
+	QVERIFY(bravoValues[0] == u8"simple");
+	QVERIFY(bravoValues[1] == u8"fish & chips");
+	QVERIFY(bravoValues[2] == u8"line one\nline two");
+	QVERIFY(bravoValues[3] == u8"");
+	QVERIFY(bravoValues[4] == bigContent);
+	QVERIFY(charlieValues.size() == 1);
+	QVERIFY(charlieValues[0] == u8"after the big one");
+}
+
+
+//-------------------------------------------------
+//  longElementNames - element names are dispatched
+//	on their first eight characters, so ensure that
+//	longer names are still told apart
+//-------------------------------------------------
+
+void XmlParser::Test::longElementNames()
+{
+	XmlParser xml;
+	std::vector<std::string> elements;
+	xml.onElementBegin({ "alpha", "abcdefgh" }, [&](const XmlParser::Attributes &)
+	{
+		elements.push_back("abcdefgh");
+	});
+	xml.onElementBegin({ "alpha", "abcdefghi" }, [&](const XmlParser::Attributes &)
+	{
+		elements.push_back("abcdefghi");
+	});
+	xml.onElementBegin({ "alpha", "configuration" }, [&](const XmlParser::Attributes &)
+	{
+		elements.push_back("configuration");
+	});
+
+	const char *xmlText =
+		"<alpha>"
+		"<abcdefgh/>"
+		"<abcdefghi/>"
+		"<abcdefghij/>"
+		"<configuration/>"
+		"<configurations/>"
+		"<configurat/>"
+		"</alpha>";
+	QVERIFY(xml.parseBytes(xmlText, strlen(xmlText)));
+	QVERIFY((elements == std::vector<std::string>{ "abcdefgh", "abcdefghi", "configuration" }));
+}
+
+
+//-------------------------------------------------
+//  parseMapped - checks that parsing a mapped file
+//	gets the same results as reading it, without
+//	copying any more than expat itself does
+//-------------------------------------------------
+
+void XmlParser::Test::parseMapped()
+{
+	// write out a file
+	QTemporaryDir tempDir;
+	QVERIFY(tempDir.isValid());
+	QString fileName = tempDir.filePath("parsemapped.xml");
+	QByteArray xmlText = "<alpha>";
+	for (int i = 0; i < 20000; i++)
+		xmlText += QString("<bravo value=\"%1\">text %1</bravo>").arg(i).toUtf8();
+	xmlText += "</alpha>";
+	{
+		QFile file(fileName);
+		QVERIFY(file.open(QIODevice::WriteOnly));
+		QVERIFY(file.write(xmlText) == xmlText.size());
+	}
+
+	// parse it both ways
+	auto parse = [&fileName, &xmlText](bool mapped, std::uint64_t &bytesCopied)
+	{
+		XmlParser xml;
+		std::int64_t valueTotal = 0;
+		int textsMatched = 0;
+		xml.onElementBegin({ "alpha", "bravo" }, [&](const XmlParser::Attributes &attributes)
+		{
+			const auto [valueAttr] = attributes.get<"value">();
+			valueTotal += valueAttr.as<int>().value_or(0);
+		});
+		xml.onElementEnd({ "alpha", "bravo" }, [&](std::u8string_view content)
+		{
+			if (content == util::toU8String(QString("text %1").arg(textsMatched)))
+				textsMatched++;
+		});
+
+		QBuffer buffer(&xmlText);
+		bool success = mapped
+			? xml.parseMapped(fileName)
+			: buffer.open(QIODevice::ReadOnly) && xml.parse(buffer);
+		bytesCopied = xml.bytesCopied();
+		return success && valueTotal == (std::int64_t)19999 * 20000 / 2 && textsMatched == 20000;
+	};
+	std::uint64_t readBytesCopied, mappedBytesCopied;
+	QVERIFY(parse(false, readBytesCopied));
+	QVERIFY(parse(true, mappedBytesCopied));
+	QVERIFY(readBytesCopied == (std::uint64_t)xmlText.size());
+	QVERIFY(mappedBytesCopied == (expatCopiesInput() ? (std::uint64_t)xmlText.size() : 0));
+
+	// whereas handing parse() a QFile reads it like any other stream (mapping is opt-in)
+	XmlParser xml;
+	QFile file(fileName);
+	QVERIFY(file.open(QIODevice::ReadOnly));
+	QVERIFY(xml.parse(file));
+	QVERIFY(xml.bytesCopied() == (std::uint64_t)xmlText.size());
+	QVERIFY(file.atEnd());
+}
+
+
+//-------------------------------------------------
+//  benchmarkAttributes - compares get() with get<>()
+//	on attributes resembling a -listxml <rom>
+//-------------------------------------------------
+
+void XmlParser::Test::benchmarkAttributes(bool compileTime)
+{
+	const char *attributesArray[] =
+	{
+		"name",		"abc.bin",
+		"size",		"4096",
+		"crc",		"deadbeef",
+		"sha1",		"0123456789abcdef0123456789abcdef01234567",
+		"region",	"maincpu",
+		"offset",	"0",
+		nullptr
+	};
+	XmlParser::Attributes attributes(attributesArray);
+
+	int found = 0;
+	QBENCHMARK
+	{
+		for (int i = 0; i < 100000; i++)
+		{
+			const auto [name, bios, size, crc, sha1, merge, region, offset, status, optional] = compileTime
+				? attributes.get<"name", "bios", "size", "crc", "sha1", "merge", "region", "offset", "status", "optional">()
+				: attributes.get("name", "bios", "size", "crc", "sha1", "merge", "region", "offset", "status", "optional");
+			found += (name ? 1 : 0) + (sha1 ? 1 : 0) + (offset ? 1 : 0) + (optional ? 1 : 0);
+		}
+	}
+	QVERIFY(found > 0);
+}
+
+
 //-------------------------------------------------
 //  attributeParsingError
 //-------------------------------------------------
@@ -14,10 +14,11 @@
 #include <expat.h>
 
 // Qt headers
-#include <QBuffer>
 #include <QCoreApplication>
+#include <QFile>
 
 // standard headers
+#include <algorithm>
 #include <charconv>
 #include <inttypes.h>
 #include <string>
@@ -166,6 +167,9 @@ thread_local XmlParser *XmlParser::s_currentParser;
 
 XmlParser::XmlParser()
 	: m_root(std::make_unique<Node>())
+	, m_capturingContent(false)
+	, m_contentInArena(false)
+	, m_bytesCopied(0)
 {
 	m_parser = XML_ParserCreate(nullptr);
 
@@ -191,18 +195,34 @@ XmlParser::~XmlParser()
 
 bool XmlParser::parse(QIODevice &input) noexcept
 {
+	return parseWith([this, &input] { return internalParse(input); });
+}
+
+
+//-------------------------------------------------
+//  parseWith - sets up and tears down state around
+//	one of the internalParse() flavors
+//-------------------------------------------------
+
+template<typename TFunc>
+bool XmlParser::parseWith(TFunc &&func) noexcept
+{
+	// flatten the node tree if handlers were registered since the last parse
+	if (m_compiledNodes.empty())
+		compile();
+
 	// push the initial node onto the stack
 	assert(m_currentNodeStack.empty());
-	m_currentNodeStack.push(m_root.get());
+	m_currentNodeStack.push_back(0);
 
 	// parse all the things!
 	s_currentParser = this;
-	bool success = internalParse(input);
+	bool success = func();
 	s_currentParser = nullptr;
 
 	// clear out the node stack and return
 	assert(!success || m_currentNodeStack.size() == 1);
-	m_currentNodeStack = decltype(m_currentNodeStack)();
+	m_currentNodeStack.clear();
 	return success;
 }
 
@@ -220,16 +240,64 @@ bool XmlParser::parse(const QString &file_name) noexcept
 }
 
 
+//-------------------------------------------------
+//  parseMapped - parses a local file by memory
+//	mapping it, falling back to reading it if it
+//	cannot be mapped
+//-------------------------------------------------
+
+bool XmlParser::parseMapped(const QString &file_name) noexcept
+{
+	QFile file(file_name);
+	if (!file.open(QFile::ReadOnly))
+		return false;
+
+	std::optional<bool> mappedResult = tryParseMapped(file);
+	return mappedResult
+		? *mappedResult
+		: parse(file);
+}
+
+
+//-------------------------------------------------
+//  tryParseMapped - returns std::nullopt without
+//	parsing anything if the file cannot be mapped
+//-------------------------------------------------
+
+std::optional<bool> XmlParser::tryParseMapped(QFile &file) noexcept
+{
+	qint64 size = file.size();
+	uchar *data = size > 0 ? file.map(0, size) : nullptr;
+	if (!data)
+		return std::nullopt;
+
+	std::span<const char> input((const char *)data, util::safe_static_cast<std::size_t>(size));
+	bool success = parseBytes(std::span(&input, 1));
+	file.unmap(data);
+	return success;
+}
+
+
 //-------------------------------------------------
 //  parseBytes
 //-------------------------------------------------
 
 bool XmlParser::parseBytes(const void *ptr, size_t sz) noexcept
 {
-	QByteArray byteArray((const char *) ptr, (int)sz);
-	QBuffer input(&byteArray);
-	return input.open(QIODevice::ReadOnly)
-		&& parse(input);
+	std::span<const char> input((const char *)ptr, sz);
+	return parseBytes(std::span(&input, 1));
+}
+
+
+//-------------------------------------------------
+//  parseBytes - parses a document that is split
+//	across several pieces of memory, as if they
+//	were concatenated
+//-------------------------------------------------
+
+bool XmlParser::parseBytes(std::span<const std::span<const char>> pieces) noexcept
+{
+	return parseWith([this, pieces] { return internalParse(pieces); });
 }
 
 
@@ -280,6 +348,84 @@ bool XmlParser::internalParse(QIODevice &input) noexcept
 }
 
 
+//-------------------------------------------------
+//  internalParse - parses input that is already in
+//	memory (and will stay there for the duration)
+//-------------------------------------------------
+
+bool XmlParser::internalParse(std::span<const std::span<const char>> pieces) noexcept
+{
+	ProfilerScope prof(CURRENT_FUNCTION);
+
+	if (LOG_XML_PARSING)
+		qDebug("XmlParser::internalParse(): beginning parse of %zu pieces in memory", pieces.size());
+
+	// expat copies whatever we hand XML_Parse() into its own buffer (see expatCopiesInput()), so
+	// we hand it modest slices; otherwise that buffer grows to the size of the whole document
+	const std::size_t sliceSize = 0x100000;
+	static const std::span<const char> emptyPiece;
+	if (pieces.empty())
+		pieces = std::span(&emptyPiece, 1);
+	m_stableInput = pieces;
+	bool done = false;
+	for (std::size_t pieceIndex = 0; !done; pieceIndex++)
+	{
+		const std::span<const char> &input = pieces[pieceIndex];
+		std::size_t position = 0;
+		bool pieceDone = false;
+		while (!pieceDone)
+		{
+			std::size_t length = std::min(sliceSize, input.size() - position);
+			pieceDone = position + length >= input.size();
+			done = pieceDone && pieceIndex + 1 >= pieces.size();
+			if (XML_Parse(m_parser, input.data() + position, (int)length, done) == XML_STATUS_ERROR)
+			{
+				// an error happened; append the error and bail out
+				appendCurrentXmlError();
+				pieceDone = done = true;
+			}
+			else if (!m_contentView.empty() && !isInStableInput(m_contentView))
+			{
+				// content pointing into expat's buffer has to be copied out before it moves
+				moveContentToArena();
+			}
+
+			if (expatCopiesInput())
+				m_bytesCopied += length;
+			position += length;
+		}
+	}
+	m_stableInput = { };
+
+	bool success = m_errors.size() == 0;
+	if (LOG_XML_PARSING)
+		qDebug("XmlParser::internalParse(): ending parse (success=%s)", success ? "true" : "false");
+	return success;
+}
+
+
+//-------------------------------------------------
+//  expatCopiesInput - when expat is built with
+//	XML_CONTEXT_BYTES (the default) XML_Parse()
+//	copies its input into expat's own buffer, so
+//	we can avoid our copy but not that one
+//-------------------------------------------------
+
+bool XmlParser::expatCopiesInput() noexcept
+{
+	static const bool result = []
+	{
+		for (const XML_Feature *feature = XML_GetFeatureList(); feature->feature != XML_FEATURE_END; feature++)
+		{
+			if (feature->feature == XML_FEATURE_CONTEXT_BYTES)
+				return true;
+		}
+		return false;
+	}();
+	return result;
+}
+
+
 //-------------------------------------------------
 //  parseSingleBuffer
 //-------------------------------------------------
@@ -307,9 +453,17 @@ bool XmlParser::parseSingleBuffer(QIODevice &input, std::optional<QFile> &xmlDat
 	// log the XML data if appropriate
 	if (xmlDataLog && lastRead > 0)
 		xmlDataLog->write((const char *) buffer, lastRead);
+	if (lastRead > 0)
+		m_bytesCopied += lastRead;
 
 	// and feed this into expat
-	return XML_ParseBuffer(m_parser, done ? 0 : lastRead, done) != XML_STATUS_ERROR;
+	bool success = XML_ParseBuffer(m_parser, done ? 0 : lastRead, done) != XML_STATUS_ERROR;
+
+	// expat may move its buffer around before the next call, so any content we are pointing into
+	// has to be copied out
+	if (!m_contentView.empty())
+		moveContentToArena();
+	return success;
 }
 
 
@@ -424,63 +578,16 @@ bool XmlParser::isWhitespace(char ch) noexcept
 }
 
 
-//-------------------------------------------------
-//  onElementEnd (const char *)
-//-------------------------------------------------
-
-void XmlParser::onElementEnd(const std::initializer_list<const char *> &elements, OnEndElementCallback &&func) noexcept
-{
-	getNode(elements).m_endFunc = std::move(func);
-}
-
-
-//-------------------------------------------------
-//  onElementEnd (multiple const char *)
-//-------------------------------------------------
-
-void XmlParser::onElementEnd(const std::initializer_list<const std::initializer_list<const char *>> &elements, OnEndElementCallback &&func) noexcept
-{
-	for (auto iter = elements.begin(); iter != elements.end(); iter++)
-	{
-		OnEndElementCallback func_duplicate(func);
-		onElementEnd(*iter, std::move(func_duplicate));
-	}
-}
-
-
-//-------------------------------------------------
-//  onElementEnd (void)
-//-------------------------------------------------
-
-void XmlParser::onElementEnd(const std::initializer_list<const char *> &elements, OnEndElementVoidCallback &&func) noexcept
-{
-	getNode(elements).m_endFunc = [func{ std::move(func) }](std::u8string &&)
-	{
-		func();
-	};
-}
-
-
-//-------------------------------------------------
-//  onElementEnd (multiple void)
-//-------------------------------------------------
-
-void XmlParser::onElementEnd(const std::initializer_list<const std::initializer_list<const char *>> &elements, OnEndElementVoidCallback &&func) noexcept
-{
-	for (auto iter = elements.begin(); iter != elements.end(); iter++)
-	{
-		OnEndElementVoidCallback func_duplicate(func);
-		onElementEnd(*iter, std::move(func_duplicate));
-	}
-}
-
-
 //-------------------------------------------------
 //  getNode
 //-------------------------------------------------
 
 XmlParser::Node &XmlParser::getNode(const std::initializer_list<const char *> &elements) noexcept
 {
+	// the tree is changing; we will need to compile it again
+	m_compiledNodes.clear();
+	m_compiledTransitions.clear();
+
 	Node *node = m_root.get();
 
 	for (auto iter = elements.begin(); iter != elements.end(); iter++)
@@ -507,36 +614,116 @@ XmlParser::Node &XmlParser::getNode(const std::initializer_list<const char *> &e
 
 
 //-------------------------------------------------
-//  startElement
+//  compile - flattens the node tree into a table
+//	of nodes and sorted transitions, so that
+//	dispatching an element is a few compares
+//	rather than a hash lookup
 //-------------------------------------------------
 
-void XmlParser::startElement(const char *element, const char **attributes) noexcept
+void XmlParser::compile() noexcept
 {
 	ProfilerScope prof(CURRENT_FUNCTION);
 
-	// only try to find this node in our tables if we are not skipping
-	const Node *currentNode = m_currentNodeStack.top();
-	const Node *childNode;
-	if (currentNode)
+	// number the nodes breadth first, with the root at index zero
+	std::vector<const Node *> nodes = { m_root.get() };
+	std::unordered_map<const Node *, std::uint32_t> nodeIndexes = { { m_root.get(), 0 } };
+	for (std::size_t i = 0; i < nodes.size(); i++)
 	{
-		// we're in a node - find the child element
-		auto iter = currentNode->m_map.find(element);
-		if (iter != currentNode->m_map.end())
+		for (const auto &[name, child] : nodes[i]->m_map)
 		{
-			// we've found the child (which could be the current node if we're recursing)
-			childNode = iter->second ? iter->second.get() : currentNode;
+			if (child && nodeIndexes.emplace(child.get(), (std::uint32_t)nodes.size()).second)
+				nodes.push_back(child.get());
 		}
-		else
+	}
+
+	// and build the transitions for each node
+	m_compiledNodes.clear();
+	m_compiledNodes.reserve(nodes.size());
+	m_compiledTransitions.clear();
+	for (std::uint32_t i = 0; i < nodes.size(); i++)
+	{
+		CompiledNode &compiledNode = m_compiledNodes.emplace_back();
+		compiledNode.m_node				= nodes[i];
+		compiledNode.m_transitionsIndex	= (std::uint32_t)m_compiledTransitions.size();
+		compiledNode.m_transitionsCount	= (std::uint32_t)nodes[i]->m_map.size();
+
+		for (const auto &[name, child] : nodes[i]->m_map)
 		{
-			// this child is unknown - we have to ignore it
-			childNode = nullptr;
+			// a null child means that we recurse into the same node
+			CompiledTransition &transition = m_compiledTransitions.emplace_back();
+			transition.m_key	= elementKey(name);
+			transition.m_name	= strlen(name) >= 8 ? name : nullptr;
+			transition.m_target	= child ? nodeIndexes[child.get()] : i;
 		}
+
+		auto transitionsBegin = m_compiledTransitions.begin() + compiledNode.m_transitionsIndex;
+		std::sort(transitionsBegin, m_compiledTransitions.end(), [](const CompiledTransition &a, const CompiledTransition &b)
+		{
+			return a.m_key < b.m_key;
+		});
 	}
-	else
+}
+
+
+//-------------------------------------------------
+//  findCompiledChild
+//-------------------------------------------------
+
+std::uint32_t XmlParser::findCompiledChild(std::uint32_t nodeIndex, const char *element) const noexcept
+{
+	const CompiledNode &node = m_compiledNodes[nodeIndex];
+	auto transitionsBegin = m_compiledTransitions.begin() + node.m_transitionsIndex;
+	auto transitionsEnd = transitionsBegin + node.m_transitionsCount;
+
+	std::uint64_t key = elementKey(element);
+	auto iter = std::lower_bound(transitionsBegin, transitionsEnd, key, [](const CompiledTransition &transition, std::uint64_t key)
 	{
-		// we're currently in an unknown node and we're ignoring it - so we need to ignore the child too
-		childNode = nullptr;
+		return transition.m_key < key;
+	});
+
+	// names of eight characters or more share keys with anything that shares their first eight
+	// characters, so we need to check the rest
+	for (; iter != transitionsEnd && iter->m_key == key; iter++)
+	{
+		if (!iter->m_name || !strcmp(iter->m_name + 8, element + 8))
+			return iter->m_target;
 	}
+	return NO_NODE;
+}
+
+
+//-------------------------------------------------
+//  elementKey - packs up to the first eight
+//	characters of an element name
+//-------------------------------------------------
+
+std::uint64_t XmlParser::elementKey(const char *element) noexcept
+{
+	std::uint64_t result = 0;
+	for (int i = 0; i < 8 && element[i]; i++)
+		result |= (std::uint64_t)(std::uint8_t)element[i] << (i * 8);
+	return result;
+}
+
+
+//-------------------------------------------------
+//  startElement
+//-------------------------------------------------
+
+void XmlParser::startElement(const char *element, const char **attributes) noexcept
+{
+	ProfilerScope prof(CURRENT_FUNCTION);
+
+	// only try to find this node in our tables if we are not skipping; if we're currently in an unknown
+	// node and we're ignoring it, we need to ignore the child too (the child could also be the current
+	// node if we're recursing)
+	std::uint32_t currentNodeIndex = m_currentNodeStack.back();
+	std::uint32_t childNodeIndex = currentNodeIndex != NO_NODE
+		? findCompiledChild(currentNodeIndex, element)
+		: NO_NODE;
+	const Node *childNode = childNodeIndex != NO_NODE
+		? m_compiledNodes[childNodeIndex].m_node
+		: nullptr;
 
 	// do we have a callback function for beginning this node?
 	if (childNode && childNode->m_beginFunc)
@@ -547,22 +734,19 @@ void XmlParser::startElement(const char *element, const char **attributes) noexc
 
 		// were we instructed to skip?
 		if (result == ElementResult::Skip)
+		{
+			childNodeIndex = NO_NODE;
 			childNode = nullptr;
+		}
 	}
 
 	// and push this onto the stack
-	m_currentNodeStack.push(childNode);
+	m_currentNodeStack.push_back(childNodeIndex);
 
-	// set up content, but only if we expect to emit it later
-	if (childNode && childNode->m_endFunc)
-	{
-		m_currentContent.emplace();
-		m_currentContent->reserve(1024);
-	}
-	else
-	{
-		m_currentContent.reset();
-	}
+	// set up content capture, but only if we expect to emit it later
+	m_capturingContent = childNode && childNode->m_endFunc && childNode->m_endFuncWantsContent;
+	m_contentView = { };
+	m_contentInArena = false;
 }
 
 
@@ -575,15 +759,25 @@ void XmlParser::endElement(const char *) noexcept
 	ProfilerScope prof(CURRENT_FUNCTION);
 
 	// call back the end func, if appropriate
-	const Node *currentNode = m_currentNodeStack.top();
+	std::uint32_t currentNodeIndex = m_currentNodeStack.back();
+	const Node *currentNode = currentNodeIndex != NO_NODE
+		? m_compiledNodes[currentNodeIndex].m_node
+		: nullptr;
 	if (currentNode && currentNode->m_endFunc)
 	{
-		currentNode->m_endFunc(m_currentContent ? std::move(*m_currentContent) : std::u8string());
-		m_currentContent.reset();
+		std::u8string_view content = m_contentInArena
+			? std::u8string_view(m_contentArena)
+			: m_contentView;
+		currentNode->m_endFunc(content);
 	}
 
+	// content is only captured for the innermost element
+	m_capturingContent = false;
+	m_contentView = { };
+	m_contentInArena = false;
+
 	// and go up the tree
-	m_currentNodeStack.pop();
+	m_currentNodeStack.pop_back();
 }
 
 
@@ -593,8 +787,80 @@ void XmlParser::endElement(const char *) noexcept
 
 void XmlParser::characterData(const char *s, int len) noexcept
 {
-	if (m_currentContent)
-		*m_currentContent += std::u8string_view((const char8_t *) s, len);
+	if (!m_capturingContent)
+		return;
+
+	// in the common case, the content arrives in one piece (or contiguous pieces) within expat's
+	// buffer and we can simply point at it; otherwise we accumulate it in the arena
+	std::u8string_view text((const char8_t *) s, len);
+	bool inBuffer = !m_contentInArena && (isInStableInput(text) || isInExpatBuffer(text));
+	if (inBuffer && m_contentView.empty())
+	{
+		m_contentView = text;
+	}
+	else if (inBuffer && m_contentView.data() + m_contentView.size() == text.data())
+	{
+		m_contentView = std::u8string_view(m_contentView.data(), m_contentView.size() + text.size());
+	}
+	else
+	{
+		moveContentToArena();
+		m_contentArena += text;
+	}
+}
+
+
+//-------------------------------------------------
+//  isInExpatBuffer - determines whether text given
+//	to characterData() points into expat's buffer
+//	(as opposed to somewhere transient, like when
+//	expat normalizes newlines)
+//-------------------------------------------------
+
+bool XmlParser::isInExpatBuffer(std::u8string_view text) const noexcept
+{
+	int offset, size;
+	const char *context = XML_GetInputContext(m_parser, &offset, &size);
+	if (!context)
+		return false;
+
+	std::uintptr_t bufferBegin = (std::uintptr_t)context;
+	std::uintptr_t textBegin = (std::uintptr_t)text.data();
+	return textBegin >= bufferBegin && textBegin + text.size() <= bufferBegin + size;
+}
+
+
+//-------------------------------------------------
+//  isInStableInput - determines whether text given
+//	to characterData() points into input that will
+//	outlive the parse
+//-------------------------------------------------
+
+bool XmlParser::isInStableInput(std::u8string_view text) const noexcept
+{
+	std::uintptr_t textBegin = (std::uintptr_t)text.data();
+	auto iter = std::ranges::find_if(m_stableInput, [textBegin, &text](const std::span<const char> &input)
+	{
+		std::uintptr_t inputBegin = (std::uintptr_t)input.data();
+		return textBegin >= inputBegin && textBegin + text.size() <= inputBegin + input.size();
+	});
+	return iter != m_stableInput.end();
+}
+
+
+//-------------------------------------------------
+//  moveContentToArena
+//-------------------------------------------------
+
+void XmlParser::moveContentToArena() noexcept
+{
+	if (!m_contentInArena)
+	{
+		// assign() reuses the arena's existing allocation
+		m_contentArena.assign(m_contentView);
+		m_contentView = { };
+		m_contentInArena = true;
+	}
 }
 
 
@@ -18,12 +18,18 @@
 #include <QIODevice>
 
 // standard headers
+#include <algorithm>
 #include <array>
+#include <bit>
+#include <cstdint>
 #include <initializer_list>
 #include <memory>
 #include <optional>
-#include <stack>
+#include <span>
+#include <stdexcept>
+#include <string_view>
 #include <type_traits>
+#include <vector>
 
 struct XML_ParserStruct;
 
@@ -106,6 +112,99 @@ public:
 	};
 
 
+	// ======================> AttributeName
+
+	// an attribute name known at compile time (see Attributes::get<>())
+	template<std::size_t N>
+	struct AttributeName
+	{
+		constexpr AttributeName(const char (&text)[N])
+		{
+			std::copy_n(text, N, m_text);
+		}
+
+		constexpr std::string_view view() const { return std::string_view(m_text, N - 1); }
+
+		char m_text[N];
+	};
+
+
+	// ======================> AttributeNameTable
+
+	// perfect hash of a set of attribute names, built at compile time; names are keyed by their
+	// length and a few of their characters, and we search for a multiplier that sends every key
+	// to its own slot
+	template<std::size_t N>
+	class AttributeNameTable
+	{
+	public:
+		consteval AttributeNameTable(const std::array<std::string_view, N> &names)
+			: m_names(names)
+			, m_multiplier(0)
+		{
+			// the keys themselves have to be distinct
+			for (std::size_t i = 0; i < N; i++)
+			{
+				for (std::size_t j = i + 1; j < N; j++)
+				{
+					if (key(names[i]) == key(names[j]))
+						throw std::logic_error("Attribute names cannot be distinguished by their keys");
+				}
+			}
+
+			// find a multiplier without collisions
+			for (std::uint32_t attempt = 0; attempt < 100000 && m_multiplier == 0; attempt++)
+			{
+				std::uint32_t multiplier = 0x9E3779B1 + attempt * 2;
+				std::ranges::fill(m_slots, EMPTY);
+
+				bool collision = false;
+				for (std::size_t i = 0; !collision && i < N; i++)
+				{
+					std::uint8_t &slot = m_slots[slotIndex(key(names[i]), multiplier)];
+					collision = slot != EMPTY;
+					slot = (std::uint8_t)i;
+				}
+				if (!collision)
+					m_multiplier = multiplier;
+			}
+			if (m_multiplier == 0)
+				throw std::logic_error("Could not build perfect hash for attribute names");
+		}
+
+		// returns the index of the name, or -1 if it is not one of ours
+		int find(const char *name) const noexcept
+		{
+			std::string_view nameView = name;
+			std::uint8_t index = m_slots[slotIndex(key(nameView), m_multiplier)];
+			return index != EMPTY && m_names[index] == nameView ? index : -1;
+		}
+
+	private:
+		static constexpr int			BITS = std::max(4, (int)std::bit_width(N * 4));
+		static constexpr std::uint8_t	EMPTY = 0xFF;
+		static_assert(N < EMPTY);
+
+		std::array<std::string_view, N>		m_names;
+		std::array<std::uint8_t, 1 << BITS>	m_slots = { };
+		std::uint32_t						m_multiplier;
+
+		static constexpr std::uint32_t key(std::string_view name) noexcept
+		{
+			auto charAt = [name](std::size_t i) { return i < name.size() ? (std::uint32_t)(std::uint8_t)name[i] : 0; };
+			return (std::uint32_t)name.size()
+				| charAt(0) << 8
+				| charAt(1) << 16
+				| (name.empty() ? 0 : charAt(name.size() - 1)) << 24;
+		}
+
+		static constexpr std::size_t slotIndex(std::uint32_t key, std::uint32_t multiplier) noexcept
+		{
+			return (key * multiplier) >> (32 - BITS);
+		}
+	};
+
+
 	// ======================> Attributes
 
 	class Attributes
@@ -113,6 +212,29 @@ public:
 	public:
 		Attributes(const char **attributes);
 
+		// bulk attribute retrieval with names known at compile time (e.g. - get<"name", "size">()); this
+		// matches each attribute with a perfect hash rather than comparing it with every name
+		template<AttributeName... TNames>
+		auto get() const noexcept
+		{
+			static constexpr AttributeNameTable<sizeof...(TNames)> table(std::array<std::string_view, sizeof...(TNames)> { TNames.view()... });
+
+			// prepare an array of results
+			std::array<Attribute, sizeof...(TNames)> results;
+			std::ranges::fill(results, Attribute((const char **)&m_zero));
+
+			// loop through all attributes
+			for (auto i = 0; m_attributes[i]; i += 2)
+			{
+				int index = table.find(m_attributes[i + 0]);
+				if (index >= 0)
+					results[index] = Attribute(&m_attributes[i + 1]);
+			}
+
+			// and return
+			return results;
+		}
+
 		// bulk attribute retrieval
 		template<typename... TArgs>
 		auto get(TArgs... attrs) const noexcept
@@ -181,21 +303,57 @@ public:
 		}
 	}
 
-	// onElementEnd (std::u8string)
-	typedef std::function<void(std::u8string &&content)> OnEndElementCallback;
-	void onElementEnd(const std::initializer_list<const char *> &elements, OnEndElementCallback &&func) noexcept;
-	void onElementEnd(const std::initializer_list<const std::initializer_list<const char *>> &elements, OnEndElementCallback &&func) noexcept;
+	// onElementEnd; TFunc can take the content as a std::u8string_view (only valid for the duration of
+	// the call, but usually pointing directly into expat's buffer), as a std::u8string or not at all
+	typedef std::function<void(std::u8string_view content)> OnEndElementCallback;
+	template<typename TFunc>
+	void onElementEnd(const std::initializer_list<const char *> &elements, TFunc &&func) noexcept
+	{
+		Node &node = getNode(elements);
+		if constexpr (std::is_invocable_v<TFunc, std::u8string_view>)
+		{
+			node.m_endFunc = std::forward<TFunc>(func);
+			node.m_endFuncWantsContent = true;
+		}
+		else if constexpr (std::is_invocable_v<TFunc, std::u8string &&>)
+		{
+			node.m_endFunc = [func{ std::forward<TFunc>(func) }](std::u8string_view content) mutable
+			{
+				func(std::u8string(content));
+			};
+			node.m_endFuncWantsContent = true;
+		}
+		else
+		{
+			node.m_endFunc = [func{ std::forward<TFunc>(func) }](std::u8string_view) mutable
+			{
+				func();
+			};
+			node.m_endFuncWantsContent = false;
+		}
+	}
 
-	// onElementEnd (void)
-	typedef std::function<void()> OnEndElementVoidCallback;
-	void onElementEnd(const std::initializer_list<const char *> &elements, OnEndElementVoidCallback &&func) noexcept;
-	void onElementEnd(const std::initializer_list<const std::initializer_list<const char *>> &elements, OnEndElementVoidCallback &&func) noexcept;
+	// onElementEnd
+	template<typename TFunc>
+	void onElementEnd(const std::initializer_list<const std::initializer_list<const char *>> &elements, const TFunc &func) noexcept
+	{
+		for (auto iter = elements.begin(); iter != elements.end(); iter++)
+		{
+			TFunc func_duplicate(func);
+			onElementEnd(*iter, std::move(func_duplicate));
+		}
+	}
 
 	bool parse(QIODevice &input) noexcept;
 	bool parse(const QString &file_name) noexcept;
+	bool parseMapped(const QString &file_name) noexcept;
 	bool parseBytes(const void *ptr, size_t sz) noexcept;
+	bool parseBytes(std::span<const std::span<const char>> pieces) noexcept;
 	QString errorMessagesSingleString() const noexcept;
 
+	// input bytes that had to be copied on their way to expat
+	std::uint64_t bytesCopied() const noexcept { return m_bytesCopied; }
+
 private:
 	struct Node
 	{
@@ -211,23 +369,54 @@ private:
 		// fields
 		OnBeginElementCallback		m_beginFunc;
 		OnEndElementCallback		m_endFunc;
+		bool						m_endFuncWantsContent = false;
 		Map							m_map;
 	};
 
-	typedef std::stack<const Node *> NodeStack;
+	// the node tree flattened into a transition table (see compile()); each node's transitions are
+	// sorted by key, which holds the first eight characters of the element name
+	struct CompiledTransition
+	{
+		std::uint64_t	m_key;
+		const char *	m_name;			// only needed when the name is eight characters or longer
+		std::uint32_t	m_target;
+	};
+
+	struct CompiledNode
+	{
+		const Node *	m_node;
+		std::uint32_t	m_transitionsIndex;
+		std::uint32_t	m_transitionsCount;
+	};
+
+	static constexpr std::uint32_t NO_NODE = ~0;
 
 	thread_local static XmlParser *	s_currentParser;
 	struct XML_ParserStruct *		m_parser;
 	Node::ptr						m_root;
-	NodeStack						m_currentNodeStack;
-	std::optional<std::u8string>	m_currentContent;
+	std::vector<CompiledNode>		m_compiledNodes;	// empty if not compiled
+	std::vector<CompiledTransition>	m_compiledTransitions;
+	std::vector<std::uint32_t>		m_currentNodeStack;	// indexes into m_compiledNodes (or NO_NODE)
+	bool							m_capturingContent;
+	std::u8string_view				m_contentView;		// content pointing into expat's buffer
+	std::u8string					m_contentArena;		// reused for content that arrives in pieces
+	bool							m_contentInArena;
+	std::span<const std::span<const char>>	m_stableInput;	// input that outlives the parse (e.g. - a mapped file)
+	std::uint64_t					m_bytesCopied;
 	std::vector<Error>				m_errors;
 
+	template<typename TFunc> bool parseWith(TFunc &&func) noexcept;
+	std::optional<bool> tryParseMapped(QFile &file) noexcept;
 	bool internalParse(QIODevice &input) noexcept;
+	bool internalParse(std::span<const std::span<const char>> pieces) noexcept;
 	bool parseSingleBuffer(QIODevice &input, std::optional<QFile> &xmlDataLog, bool &done) noexcept;
 	void startElement(const char *name, const char **attributes) noexcept;
 	void endElement(const char *name) noexcept;
 	void characterData(const char *s, int len) noexcept;
+	bool isInExpatBuffer(std::u8string_view text) const noexcept;
+	bool isInStableInput(std::u8string_view text) const noexcept;
+	static bool expatCopiesInput() noexcept;
+	void moveContentToArena() noexcept;
 	void appendError(QString &&message) noexcept;
 	void appendCurrentXmlError() noexcept;
 	QString errorContext() const noexcept;
@@ -235,6 +424,9 @@ private:
 	static bool isLineEnding(char ch) noexcept;
 	static bool isWhitespace(char ch) noexcept;
 	Node &getNode(const std::initializer_list<const char *> &elements) noexcept;
+	void compile() noexcept;
+	std::uint32_t findCompiledChild(std::uint32_t nodeIndex, const char *element) const noexcept;
+	static std::uint64_t elementKey(const char *element) noexcept;
 
 	static void startElementHandler(void *user_data, const char *name, const char **attributes);
 	static void endElementHandler(void *user_data, const char *name);